@@ -4,6 +4,7 @@
 #include <vzt/camera.hpp>
 #include <vzt/compiler.hpp>
 #include <vzt/core/logger.hpp>
+#include <vzt/vulkan/buffer_pool.hpp>
 #include <vzt/vulkan/command.hpp>
 #include <vzt/vulkan/descriptor.hpp>
 #include <vzt/vulkan/pipeline/graphics.hpp>
@@ -34,7 +35,16 @@ int main(int /* argc */, char** /* argv */)
     auto swapchain = vzt::Swapchain{device, surface};
 
     const vzt::Format depthFormat = hardware.getDepthFormat();
-    const auto        program     = vzt::Program(device, compiler("shaders/base/base.slang"));
+
+    // Matrices are bound with a dynamic offset in the per-frame uniform allocator
+    std::vector<vzt::Shader> shaders = compiler("shaders/base/base.slang");
+    for (vzt::Shader& shader : shaders)
+    {
+        if (auto binding = shader.bindings.find(0); binding != shader.bindings.end())
+            binding->second = vzt::DescriptorType::UniformBufferDynamic;
+    }
+
+    const auto program = vzt::Program(device, std::move(shaders));
 
     vzt::VertexInputDescription vertexDescription{};
     vertexDescription.add(vzt::VertexBinding::Typed<VertexInput>(0));
@@ -47,8 +57,8 @@ int main(int /* argc */, char** /* argv */)
                                                     .setDepth(depthFormat));
 
     // Initialize descriptors
-    vzt::DescriptorPool descriptorPool{device, pipeline, swapchain.getImageNb()};
-    vzt::UniformBuffer  ubo = {device, sizeof(vzt::Mat4) * 3, swapchain.getImageNb(), true};
+    vzt::DescriptorPool       descriptorPool{device, pipeline, swapchain.getImageNb()};
+    vzt::DynamicUniformBuffer ubo = {device, sizeof(vzt::Mat4) * 3, swapchain.getImageNb(), sizeof(vzt::Mat4) * 3};
 
     vzt::Extent2D extent = swapchain.getExtent();
 
@@ -58,23 +68,30 @@ int main(int /* argc */, char** /* argv */)
 
     for (uint32_t i = 0; i < swapchain.getImageNb(); i++)
     {
-        descriptorPool.update(i, {{0, ubo.getDescriptor(i)}});
+        descriptorPool.update(i, {{0, ubo.getDescriptor()}});
         depthStencils[i] = vzt::DeviceImage(device, extent, vzt::ImageUsage::DepthStencilAttachment, depthFormat);
         imageViews[i]    = vzt::ImageView(device, swapchain.getImage(i), vzt::ImageAspect::Color);
         depthViews[i]    = vzt::ImageView(device, depthStencils[i], vzt::ImageAspect::Depth);
     }
 
     // Vertex inputs
-    vzt::Mesh   mesh = vzt::readObj("samples/Dragon/dragon.obj");
-    vzt::Buffer vertexBuffer;
-    vzt::Buffer indexBuffer;
+    vzt::Mesh             mesh = vzt::readObj("samples/Dragon/dragon.obj");
+    vzt::BufferPool       geometryPool{device, vzt::BufferUsage::VertexBuffer | vzt::BufferUsage::IndexBuffer};
+    vzt::BufferAllocation vertexBuffer;
+    vzt::BufferAllocation indexBuffer;
     {
         std::vector<VertexInput> vertexInputs = std::vector<VertexInput>(mesh.vertices.size());
         for (std::size_t i = 0; i < mesh.vertices.size(); i++)
             vertexInputs[i] = VertexInput(mesh.vertices[i], mesh.normals[i]);
 
-        vertexBuffer = vzt::Buffer::From<VertexInput>(device, vertexInputs, vzt::BufferUsage::VertexBuffer);
-        indexBuffer  = vzt::Buffer::From<uint32_t>(device, mesh.indices, vzt::BufferUsage::IndexBuffer);
+        // Both ranges share the same buffer
+        vertexBuffer = geometryPool.allocate<VertexInput>(vertexInputs.size());
+        indexBuffer  = geometryPool.allocate<uint32_t>(mesh.indices.size());
+
+        vzt::UploadManager& uploader = device.getUploadManager();
+        uploader.upload<VertexInput>(vertexInputs, *vertexBuffer.span.buffer, vertexBuffer.span.offset);
+        uploader.upload<uint32_t>(mesh.indices, *indexBuffer.span.buffer, indexBuffer.span.offset);
+        uploader.wait(uploader.flush());
     }
 
     // Compute AABB to place camera in front of the model
@@ -135,13 +152,13 @@ int main(int /* argc */, char** /* argv */)
 
         extent = swapchain.getExtent();
 
+        ubo.reset(frame);
+        const uint32_t matricesOffset = ubo.push(vzt::CSpan<vzt::Mat4>{matrices.data(), matrices.size()});
+        ubo.flush();
+
         vzt::CommandBuffer commands = commandPool[frame];
         commands.begin();
         {
-            ubo.write(commands, vzt::CSpan<vzt::Mat4>{matrices.data(), matrices.size()}, frame);
-            commands.barrier(vzt::PipelineStage::Transfer, vzt::PipelineStage::VertexShader,
-                             {ubo.getSpan(frame), vzt::Access::TransferWrite, vzt::Access::UniformRead});
-
             vzt::ImageBarrier imageBarrier{};
             imageBarrier.image     = swapchain.getImage(submission->imageId);
             imageBarrier.oldLayout = vzt::ImageLayout::Undefined;
@@ -166,10 +183,10 @@ int main(int /* argc */, char** /* argv */)
                     },
             });
 
-            commands.bind(pipeline, descriptorPool[frame]);
-            commands.bindVertexBuffer(vertexBuffer);
+            commands.bind(pipeline, descriptorPool[frame], matricesOffset);
+            commands.bindVertexBuffer(vertexBuffer.span);
             for (const auto& subMesh : mesh.subMeshes)
-                commands.drawIndexed(indexBuffer, subMesh.indices);
+                commands.drawIndexed(indexBuffer.span, subMesh.indices);
 
             commands.endRendering();
 
@@ -193,7 +210,7 @@ int main(int /* argc */, char** /* argv */)
 
             for (uint32_t i = 0; i < swapchain.getImageNb(); i++)
             {
-                descriptorPool.update(i, {{0, ubo.getDescriptor(i)}});
+                descriptorPool.update(i, {{0, ubo.getDescriptor()}});
                 depthStencils[i] =
                     vzt::DeviceImage(device, extent, vzt::ImageUsage::DepthStencilAttachment, depthFormat);
                 imageViews[i] = vzt::ImageView(device, swapchain.getImage(i), vzt::ImageAspect::Color);
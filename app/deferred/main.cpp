@@ -1,6 +1,7 @@
 #include <vzt/camera.hpp>
 #include <vzt/compiler.hpp>
 #include <vzt/core/logger.hpp>
+#include <vzt/core/thread_pool.hpp>
 #include <vzt/render_graph.hpp>
 #include <vzt/vulkan/query_pool.hpp>
 #include <vzt/vulkan/surface.hpp>
@@ -35,11 +36,9 @@ int main(int /* argc */, char** /* argv */)
 
     auto deviceBuilder = vzt::DeviceBuilder::standard();
     deviceBuilder.add(VK_KHR_SHADER_DRAW_PARAMETERS_EXTENSION_NAME);
+    deviceBuilder.setPipelineCachePath("cache/deferred_pipelines.bin");
     auto device = instance.getDevice(deviceBuilder, surface);
 
-    auto        hardware = device.getHardware();
-    const float period   = hardware.getProperties().limits.timestampPeriod;
-
     auto swapchain = vzt::Swapchain{device, surface};
     auto compiler  = vzt::Compiler(instance);
     auto graph     = vzt::RenderGraph{device};
@@ -57,8 +56,24 @@ int main(int /* argc */, char** /* argv */)
         max = glm::max(max, vertex);
     }
 
-    const auto vertexBuffer = vzt::Buffer::From<VertexInput>(device, vertexInputs, vzt::BufferUsage::VertexBuffer);
-    const auto indexBuffer  = vzt::Buffer::From<uint32_t>(device, mesh.indices, vzt::BufferUsage::IndexBuffer);
+    // Both uploads share the same submission
+    vzt::UploadBatch uploads{device};
+    const auto       vertexBuffer = uploads.createBuffer<VertexInput>(vertexInputs, vzt::BufferUsage::VertexBuffer);
+    const auto       indexBuffer  = uploads.createBuffer<uint32_t>(mesh.indices, vzt::BufferUsage::IndexBuffer);
+    uploads.wait();
+
+    // Programs of all passes are compiled concurrently
+    std::vector<std::vector<vzt::Shader>> programs;
+    {
+        const std::vector<vzt::ShaderCompilation> compilations = {
+            {"shaders/deferred/instance_generation.slang", "main"},
+            {"shaders/deferred/triangle.slang"},
+            {"shaders/deferred/deferred_blinn_phong.slang"},
+        };
+
+        vzt::ThreadPool compilationThreads{};
+        programs = compiler(compilations, compilationThreads);
+    }
 
     vzt::VertexInputDescription vertexDescription{};
     vertexDescription.add(vzt::VertexBinding::Typed<VertexInput>(0));
@@ -72,7 +87,7 @@ int main(int /* argc */, char** /* argv */)
 
     // Instance generation pass
     auto& instanceGeneration = graph.addCompute( //
-        "InstanceGeneration", compiler("shaders/deferred/instance_generation.slang", "main"));
+        "InstanceGeneration", std::move(programs[0].front()));
     {
         instanceGeneration.getDescriptorLayout().addBinding(0, vzt::DescriptorType::UniformBuffer);
         instanceGeneration.addStorageOutput(1, instancesPosition);
@@ -85,7 +100,7 @@ int main(int /* argc */, char** /* argv */)
                 uint8_t*                           data           = buffer->map();
                 const VkDrawIndexedIndirectCommand defaultCommand = {uint32_t(mesh.indices.size()), 0, 0, 0, 0};
                 std::memcpy(data, &defaultCommand, sizeof(VkDrawIndexedIndirectCommand));
-                buffer->unMap();
+                buffer->flush(0, sizeof(VkDrawIndexedIndirectCommand));
 
                 vzt::BufferBarrier barrier{*buffer, vzt::Access::TransferWrite, vzt::Access::ShaderWrite};
                 commands.barrier(vzt::PipelineStage::Transfer, vzt::PipelineStage::VertexShader, barrier);
@@ -103,7 +118,7 @@ int main(int /* argc */, char** /* argv */)
         graph.addAttachment({.usage = vzt::ImageUsage::ColorAttachment, .format = vzt::Format::R8G8B8A8SNorm});
     auto depth = graph.addAttachment({vzt::ImageUsage::DepthStencilAttachment});
 
-    auto& geometry = graph.addGraphics("Geometry", compiler("shaders/deferred/triangle.slang"));
+    auto& geometry = graph.addGraphics("Geometry", std::move(programs[1]));
     {
         geometry.getDescriptorLayout().addBinding(0, vzt::DescriptorType::UniformBuffer);
         geometry.addStorageInput(1, instancesPosition);
@@ -162,7 +177,7 @@ int main(int /* argc */, char** /* argv */)
     auto composed      = graph.addAttachment({vzt::ImageUsage::ColorAttachment});
     auto composedDepth = graph.addAttachment({vzt::ImageUsage::DepthStencilAttachment});
 
-    auto& shading = graph.addGraphics("Shading", compiler("shaders/deferred/deferred_blinn_phong.slang"));
+    auto& shading = graph.addGraphics("Shading", std::move(programs[2]));
     {
         shading.addColorTextureInput(0, position);
         shading.addColorTextureInput(1, normal);
@@ -206,14 +221,9 @@ int main(int /* argc */, char** /* argv */)
     }
 
     graph.setBackbuffer(swapchain, composed);
+    graph.setProfiling(true);
     graph.compile();
 
-    const vzt::QueryPool queryPool = {
-        device,
-        vzt::QueryType::Timestamp,
-        swapchain.getImageNb() * (graph.size() + 1) * 2,
-    };
-
     // Initialize buffer with default values
     const uint32_t     frameNb       = swapchain.getImageNb();
     vzt::UniformBuffer modelsUbo     = vzt::UniformBuffer(device, sizeof(vzt::Mat4) * 3, frameNb, true);
@@ -250,9 +260,7 @@ int main(int /* argc */, char** /* argv */)
     const vzt::Vec3 target   = (minimum + maximum) * .5f;
     const float     bbRadius = glm::compMax(glm::abs(maximum - target));
 
-    std::vector<uint64_t> times{};
-    times.resize((graph.size() + 1) * swapchain.getImageNb() * 2);
-    bool hasBenchmark = false;
+    uint64_t frameId = 0;
 
     // Actual rendering
     while (window.update())
@@ -265,30 +273,21 @@ int main(int /* argc */, char** /* argv */)
         if (!submission)
             continue;
 
-        const uint32_t startId = submission->imageId * (graph.size() + 1) * 2;
-        if (hasBenchmark)
+        // Log GPU timings over the last frames
+        if (++frameId % 256 == 0)
         {
-            queryPool.getResults(startId, (graph.size() + 1) * 2,
-                                 vzt::Span<uint64_t>(times.data() + startId, (graph.size() + 1) * 2), sizeof(uint64_t),
-                                 vzt::QueryResultFlag::N64 | vzt::QueryResultFlag::Wait);
-
-            for (uint32_t i = 0; i < graph.size(); i++)
+            const vzt::GpuProfiler& profiler = graph.getProfiler();
+            for (const auto& pass : graph)
             {
-                auto& pass = graph[i];
-
-                const float ms =
-                    (static_cast<float>(times[startId + i * 2 + 1] - times[startId + i * 2 + 0]) * period) / 1000000.f;
-
-                vzt::logger::info("{}: {}ms", pass->getName(), ms);
+                if (const auto statistics = profiler.getStatistics(pass->getName()))
+                    vzt::logger::info("{}: {:.3f}ms (min: {:.3f}ms, p95: {:.3f}ms, max: {:.3f}ms)", pass->getName(),
+                                      statistics->average, statistics->min, statistics->p95, statistics->max);
             }
 
-            const float ms =
-                (static_cast<float>(times[startId + graph.size() * 2 + 1] - times[startId + graph.size() * 2 + 0]) *
-                 period) /
-                1000000.f;
-            vzt::logger::info("Total: {}ms", ms);
+            if (const auto statistics = profiler.getStatistics(vzt::RenderGraph::ProfilerScope))
+                vzt::logger::info("Total: {:.3f}ms (min: {:.3f}ms, p95: {:.3f}ms, max: {:.3f}ms)", statistics->average,
+                                  statistics->min, statistics->p95, statistics->max);
         }
-        hasBenchmark |= submission->imageId == (swapchain.getImageNb() - 1);
 
         // Per frame update
         vzt::Quat orientation = {1.f, 0.f, 0.f, 0.f};
@@ -330,16 +329,7 @@ int main(int /* argc */, char** /* argv */)
         generationUbo.write(commands, generationInput, submission->imageId);
         modelsUbo.write(commands, matrices, submission->imageId);
 
-        commands.reset(queryPool, submission->imageId * (graph.size() + 1) * 2, (graph.size() + 1) * 2);
-        commands.writeTimeStamp(queryPool, startId + graph.size() * 2 + 0, vzt::PipelineStage::BottomOfPipe);
-        for (uint32_t i = 0; i < graph.size(); i++)
-        {
-            auto& pass = graph[i];
-            commands.writeTimeStamp(queryPool, startId + i * 2 + 0, vzt::PipelineStage::BottomOfPipe);
-            pass->record(submission->imageId, commands);
-            commands.writeTimeStamp(queryPool, startId + i * 2 + 1, vzt::PipelineStage::BottomOfPipe);
-        }
-        commands.writeTimeStamp(queryPool, startId + graph.size() * 2 + 1, vzt::PipelineStage::BottomOfPipe);
+        graph.record(submission->imageId, commands);
 
         {
             vzt::ImageBarrier imageBarrier{};
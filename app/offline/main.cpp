@@ -220,6 +220,9 @@ int main(int /* argc */, char** /* argv */)
         graphicsQueue->submit(commands);
     };
 
+    // Device writes are made visible to the host in case the memory is not host coherent
+    targetImage.invalidate();
+
     const vzt::SubresourceLayout subresourceLayout = targetImage.getSubresourceLayout(vzt::ImageAspect::Color);
     const uint8_t*               mappedData        = targetImage.map<uint8_t>();
     mappedData += subresourceLayout.offset;
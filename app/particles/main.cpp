@@ -35,11 +35,9 @@ int main(int /* argc */, char** /* argv */)
 
     auto deviceBuilder = vzt::DeviceBuilder::standard();
     deviceBuilder.add(VK_KHR_SHADER_DRAW_PARAMETERS_EXTENSION_NAME);
+    deviceBuilder.setAsyncCompute(true);
     auto device = instance.getDevice(deviceBuilder, surface);
 
-    auto        hardware = device.getHardware();
-    const float period   = hardware.getProperties().limits.timestampPeriod;
-
     auto swapchain = vzt::Swapchain{device, surface};
     auto compiler  = vzt::Compiler(instance);
     auto graph     = vzt::RenderGraph{device};
@@ -64,10 +62,10 @@ int main(int /* argc */, char** /* argv */)
                 uint8_t*                           data           = buffer->map();
                 const VkDrawIndexedIndirectCommand defaultCommand = {6, 0, 0, 0, 0};
                 std::memcpy(data, &defaultCommand, sizeof(VkDrawIndexedIndirectCommand));
-                buffer->unMap();
+                buffer->flush(0, sizeof(VkDrawIndexedIndirectCommand));
 
-                vzt::BufferBarrier barrier{*buffer, vzt::Access::TransferWrite, vzt::Access::ShaderWrite};
-                commands.barrier(vzt::PipelineStage::Transfer, vzt::PipelineStage::VertexShader, barrier);
+                vzt::BufferBarrier barrier{*buffer, vzt::Access::HostWrite, vzt::Access::ShaderWrite};
+                commands.barrier(vzt::PipelineStage::Host, vzt::PipelineStage::ComputeShader, barrier);
 
                 commands.bind(instanceGeneration.getPipeline(), set);
                 commands.dispatch(
@@ -125,14 +123,10 @@ int main(int /* argc */, char** /* argv */)
     }
 
     graph.setBackbuffer(swapchain, color);
+    graph.setProfiling(true);
+    graph.setAsyncCompute(true);
     graph.compile();
 
-    const vzt::QueryPool queryPool = {
-        device,
-        vzt::QueryType::Timestamp,
-        swapchain.getImageNb() * (graph.size() + 1) * 2,
-    };
-
     // Initialize buffer with default values
     const uint32_t     frameNb       = swapchain.getImageNb();
     vzt::UniformBuffer modelsUbo     = vzt::UniformBuffer(device, sizeof(vzt::Mat4) * 3, frameNb, true);
@@ -164,9 +158,7 @@ int main(int /* argc */, char** /* argv */)
     const vzt::Vec3 target   = (minimum + maximum) * .5f;
     const float     bbRadius = glm::compMax(glm::abs(maximum - target));
 
-    std::vector<uint64_t> times{};
-    times.resize((graph.size() + 1) * swapchain.getImageNb() * 2);
-    bool hasBenchmark = false;
+    uint64_t frameId = 0;
 
     // Actual rendering
     while (window.update())
@@ -179,30 +171,21 @@ int main(int /* argc */, char** /* argv */)
         if (!submission)
             continue;
 
-        const uint32_t startId = submission->imageId * (graph.size() + 1) * 2;
-        if (hasBenchmark)
+        // Log GPU timings over the last frames
+        if (++frameId % 256 == 0)
         {
-            queryPool.getResults(startId, (graph.size() + 1) * 2,
-                                 vzt::Span<uint64_t>(times.data() + startId, (graph.size() + 1) * 2), sizeof(uint64_t),
-                                 vzt::QueryResultFlag::N64 | vzt::QueryResultFlag::Wait);
-
-            for (uint32_t i = 0; i < graph.size(); i++)
+            const vzt::GpuProfiler& profiler = graph.getProfiler();
+            for (const auto& pass : graph)
             {
-                auto& pass = graph[i];
-
-                const float ms =
-                    (static_cast<float>(times[startId + i * 2 + 1] - times[startId + i * 2 + 0]) * period) / 1000000.f;
-
-                vzt::logger::info("{}: {}ms", pass->getName(), ms);
+                if (const auto statistics = profiler.getStatistics(pass->getName()))
+                    vzt::logger::info("{}: {:.3f}ms (min: {:.3f}ms, p95: {:.3f}ms, max: {:.3f}ms)", pass->getName(),
+                                      statistics->average, statistics->min, statistics->p95, statistics->max);
             }
 
-            const float ms =
-                (static_cast<float>(times[startId + graph.size() * 2 + 1] - times[startId + graph.size() * 2 + 0]) *
-                 period) /
-                1000000.f;
-            vzt::logger::info("Total: {}ms", ms);
+            if (const auto statistics = profiler.getStatistics(vzt::RenderGraph::ProfilerScope))
+                vzt::logger::info("Total: {:.3f}ms (min: {:.3f}ms, p95: {:.3f}ms, max: {:.3f}ms)", statistics->average,
+                                  statistics->min, statistics->p95, statistics->max);
         }
-        hasBenchmark |= submission->imageId == (swapchain.getImageNb() - 1);
 
         // Per frame update
         vzt::Quat orientation = {1.f, 0.f, 0.f, 0.f};
@@ -242,19 +225,14 @@ int main(int /* argc */, char** /* argv */)
             uint32_t(inputs.time),
         };
 
-        generationUbo.write(commands, generationInput, submission->imageId);
+        // Written from the host since the generation may run on the compute queue
+        uint8_t* generationData = generationUbo.map(submission->imageId);
+        std::memcpy(generationData, &generationInput, sizeof(GenerationInput));
+        generationUbo.flush(submission->imageId);
+
         modelsUbo.write(commands, matrices, submission->imageId);
 
-        commands.reset(queryPool, submission->imageId * (graph.size() + 1) * 2, (graph.size() + 1) * 2);
-        commands.writeTimeStamp(queryPool, startId + graph.size() * 2 + 0, vzt::PipelineStage::BottomOfPipe);
-        for (uint32_t i = 0; i < graph.size(); i++)
-        {
-            auto& pass = graph[i];
-            commands.writeTimeStamp(queryPool, startId + i * 2 + 0, vzt::PipelineStage::BottomOfPipe);
-            pass->record(submission->imageId, commands);
-            commands.writeTimeStamp(queryPool, startId + i * 2 + 1, vzt::PipelineStage::BottomOfPipe);
-        }
-        commands.writeTimeStamp(queryPool, startId + graph.size() * 2 + 1, vzt::PipelineStage::BottomOfPipe);
+        graph.record(submission->imageId, commands);
 
         {
             vzt::ImageBarrier imageBarrier{};
@@ -266,7 +244,8 @@ int main(int /* argc */, char** /* argv */)
 
         commands.end();
 
-        graphicsQueue->submit(commands, *submission);
+        const std::vector<vzt::SemaphoreWait> waits = graph.submitAsync(submission->imageId);
+        graphicsQueue->submit(commands, *submission, waits);
         if (!swapchain.present())
         {
             // Wait all commands execution
@@ -41,12 +41,11 @@ int main(int /* argc */, char** /* argv */)
 
         auto& physicalFeatures                = deviceBuilder.getDeviceFeatures().getPhysicalFeatures();
         physicalFeatures.features.shaderInt64 = true;
+
+        deviceBuilder.setAsyncCompute(true);
     }
     auto device = instance.getDevice(deviceBuilder, surface);
 
-    auto        hardware = device.getHardware();
-    const float period   = hardware.getProperties().limits.timestampPeriod;
-
     std::vector<uint32_t> indices = {
         0, 2, 1, 2, 3, 1, //
         5, 4, 1, 1, 4, 0, //
@@ -70,7 +69,10 @@ int main(int /* argc */, char** /* argv */)
     });
 
     // Instance generation pass
-    auto& sdfGeneration = graph.addCompute("SDF generation", compiler("shaders/sdf/grid.slang", "main"));
+    const vzt::ShaderPermutation gridPermutation = {.defines = {{"WORK_GROUP_SIZE", std::to_string(WorkGroupSize)}}};
+
+    auto& sdfGeneration = graph.addCompute( //
+        "SDF generation", compiler("shaders/sdf/grid.slang", "main", gridPermutation));
     {
         sdfGeneration.getDescriptorLayout().addBinding(0, vzt::DescriptorType::UniformBuffer);
         sdfGeneration.addStorageOutput(1, sdfTexture);
@@ -127,14 +129,10 @@ int main(int /* argc */, char** /* argv */)
     }
 
     graph.setBackbuffer(swapchain, color);
+    graph.setProfiling(true);
+    graph.setAsyncCompute(true);
     graph.compile();
 
-    const vzt::QueryPool queryPool = {
-        device,
-        vzt::QueryType::Timestamp,
-        swapchain.getImageNb() * (graph.size() + 1) * 2,
-    };
-
     // Initialize buffer with default values
     const uint32_t     frameNb       = swapchain.getImageNb();
     vzt::UniformBuffer generationUbo = vzt::UniformBuffer::Typed<GenerationInput>(device, frameNb, true);
@@ -166,9 +164,7 @@ int main(int /* argc */, char** /* argv */)
     const vzt::Vec3 target   = (minimum + maximum) * .5f;
     const float     bbRadius = glm::compMax(glm::abs(maximum - target));
 
-    std::vector<uint64_t> times{};
-    times.resize((graph.size() + 1) * swapchain.getImageNb() * 2);
-    bool hasBenchmark = false;
+    uint64_t frameId = 0;
 
     // Actual rendering
     while (window.update())
@@ -181,30 +177,21 @@ int main(int /* argc */, char** /* argv */)
         if (!submission)
             continue;
 
-        const uint32_t startId = submission->imageId * (graph.size() + 1) * 2;
-        if (hasBenchmark)
+        // Log GPU timings over the last frames
+        if (++frameId % 256 == 0)
         {
-            queryPool.getResults(startId, (graph.size() + 1) * 2,
-                                 vzt::Span(times.data() + startId, (graph.size() + 1) * 2), sizeof(uint64_t),
-                                 vzt::QueryResultFlag::N64 | vzt::QueryResultFlag::Wait);
-
-            for (uint32_t i = 0; i < graph.size(); i++)
+            const vzt::GpuProfiler& profiler = graph.getProfiler();
+            for (const auto& pass : graph)
             {
-                auto& pass = graph[i];
-
-                const float ms =
-                    (static_cast<float>(times[startId + i * 2 + 1] - times[startId + i * 2 + 0]) * period) / 1000000.f;
-
-                vzt::logger::info("{}: {}ms", pass->getName(), ms);
+                if (const auto statistics = profiler.getStatistics(pass->getName()))
+                    vzt::logger::info("{}: {:.3f}ms (min: {:.3f}ms, p95: {:.3f}ms, max: {:.3f}ms)", pass->getName(),
+                                      statistics->average, statistics->min, statistics->p95, statistics->max);
             }
 
-            const float ms =
-                (static_cast<float>(times[startId + graph.size() * 2 + 1] - times[startId + graph.size() * 2 + 0]) *
-                 period) /
-                1000000.f;
-            vzt::logger::info("Total: {}ms", ms);
+            if (const auto statistics = profiler.getStatistics(vzt::RenderGraph::ProfilerScope))
+                vzt::logger::info("Total: {:.3f}ms (min: {:.3f}ms, p95: {:.3f}ms, max: {:.3f}ms)", statistics->average,
+                                  statistics->min, statistics->p95, statistics->max);
         }
-        hasBenchmark |= submission->imageId == (swapchain.getImageNb() - 1);
 
         // Per frame update
         vzt::Quat orientation = {1.f, 0.f, 0.f, 0.f};
@@ -244,19 +231,14 @@ int main(int /* argc */, char** /* argv */)
         vzt::CommandBuffer commands = commandPool[submission->imageId];
         commands.begin();
 
-        generationUbo.write(commands, generationInput, submission->imageId);
+        // Written from the host since the generation may run on the compute queue
+        uint8_t* generationData = generationUbo.map(submission->imageId);
+        std::memcpy(generationData, &generationInput, sizeof(GenerationInput));
+        generationUbo.flush(submission->imageId);
+
         raycastUbo.write(commands, raycastInput, submission->imageId);
 
-        commands.reset(queryPool, submission->imageId * (graph.size() + 1) * 2, (graph.size() + 1) * 2);
-        commands.writeTimeStamp(queryPool, startId + graph.size() * 2 + 0, vzt::PipelineStage::BottomOfPipe);
-        for (uint32_t i = 0; i < graph.size(); i++)
-        {
-            auto& pass = graph[i];
-            commands.writeTimeStamp(queryPool, startId + i * 2 + 0, vzt::PipelineStage::BottomOfPipe);
-            pass->record(submission->imageId, commands);
-            commands.writeTimeStamp(queryPool, startId + i * 2 + 1, vzt::PipelineStage::BottomOfPipe);
-        }
-        commands.writeTimeStamp(queryPool, startId + graph.size() * 2 + 1, vzt::PipelineStage::BottomOfPipe);
+        graph.record(submission->imageId, commands);
 
         {
             vzt::ImageBarrier imageBarrier{};
@@ -268,7 +250,8 @@ int main(int /* argc */, char** /* argv */)
 
         commands.end();
 
-        graphicsQueue->submit(commands, *submission);
+        const std::vector<vzt::SemaphoreWait> waits = graph.submitAsync(submission->imageId);
+        graphicsQueue->submit(commands, *submission, waits);
         if (!swapchain.present())
         {
             // Wait all commands execution
@@ -12,6 +12,7 @@
 //
 
 #include <vzt/vulkan/command.hpp>
+#include <vzt/vulkan/pipeline/cache.hpp>
 #include <vzt/vulkan/surface.hpp>
 #include <vzt/vulkan/swapchain.hpp>
 #include <vzt/window.hpp>
@@ -54,7 +55,7 @@ class Ui
         vzt::View<vzt::Queue> graphicsQueue = m_device->getQueue(vzt::QueueType::Graphics);
         init_info.QueueFamily               = graphicsQueue->getId();
         init_info.Queue                     = graphicsQueue->getHandle();
-        init_info.PipelineCache             = VK_NULL_HANDLE;
+        init_info.PipelineCache             = m_device->getPipelineCache().getHandle();
 
         std::unordered_set poolTypes = {
             vzt::DescriptorType::Sampler,
@@ -10,6 +10,33 @@ namespace vzt
 {
     class Instance;
     class Module;
+    class ThreadPool;
+
+    struct ShaderDefine
+    {
+        std::string name;
+        std::string value = "1";
+    };
+
+    // Variant of a shader: defines are applied when compiling and specialization constants when creating pipelines.
+    // Permutations which only differ by their specialization constants share the same compiled code.
+    struct ShaderPermutation
+    {
+        std::vector<ShaderDefine>           defines   = {};
+        std::vector<SpecializationConstant> constants = {};
+
+        // Independent of the order of defines and constants
+        std::string getKey() const;
+    };
+
+    struct ShaderCompilation
+    {
+        Path              path;
+        std::string       entryPoint; // All entry points of the file if empty
+        CSpan<Module>     modules     = {};
+        ShaderPermutation permutation = {};
+    };
+
     class Compiler
     {
       public:
@@ -21,14 +48,42 @@ namespace vzt
 
         ~Compiler();
 
+        // Compilations may be requested from several threads, they are serialized on the shared Slang sessions
         Shader operator()(const Path& path, const std::string& entryPoint, CSpan<Module> modules = {}) const;
         std::vector<Shader> operator()(const Path& path, CSpan<Module> modules = {}) const;
 
+        Shader operator()(const Path& path, const std::string& entryPoint, const ShaderPermutation& permutation,
+                          CSpan<Module> modules = {}) const;
+        std::vector<Shader> operator()(const Path& path, const ShaderPermutation& permutation,
+                                       CSpan<Module> modules = {}) const;
+
+        // Compiles all jobs concurrently on the threads of pool, each thread using its own Slang session.
+        // Results are in the order of compilations.
+        std::vector<std::vector<Shader>> operator()(CSpan<ShaderCompilation> compilations, ThreadPool& pool) const;
+
         Module load(const Path& path) const;
 
+        // Compiled shaders and their reflected bindings are stored in directory under a hash of the source path, the
+        // entry point, the linked modules and the compiler options. Entries are only used if none of the files the
+        // source depended on has changed since. Disabled when empty (default).
+        void setCacheDirectory(Path directory);
+
+        // Compiled shaders are kept in memory so that each permutation of a file is compiled once. Clearing them forces
+        // the following requests to use the cache directory or to compile again.
+        void clear();
+
       private:
+        uint64_t getKey(const ShaderCompilation& compilation) const;
+        Path     getCachePath(uint64_t key) const;
+
+        Optional<std::vector<Shader>> find(uint64_t key) const;
+        void                          store(uint64_t key, const std::vector<Shader>& shaders) const;
+
+        std::vector<Shader> compile(const ShaderCompilation& compilation) const;
+
         View<Instance>    m_instance{};
         std::vector<Path> m_includePaths{};
+        Path              m_cacheDirectory{};
 
         struct Implementation;
         std::unique_ptr<Implementation> m_implementation;
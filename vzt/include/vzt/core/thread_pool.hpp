@@ -0,0 +1,52 @@
+#ifndef VZT_CORE_THREAD_POOL_HPP
+#define VZT_CORE_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace vzt
+{
+    // Fixed set of worker threads executing tasks in submission order
+    class ThreadPool
+    {
+      public:
+        using Task = std::function<void(uint32_t threadId)>;
+
+        ThreadPool(uint32_t threadNb = std::thread::hardware_concurrency());
+
+        ThreadPool(const ThreadPool&)            = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ThreadPool(ThreadPool&&)            = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+
+        ~ThreadPool();
+
+        void submit(Task task);
+
+        // Calls task(i, threadId) for every i in [0, count) and waits for all of them. The first exception thrown by
+        // a task is rethrown once all of them are complete.
+        void parallelFor(uint32_t count, const std::function<void(uint32_t i, uint32_t threadId)>& task);
+
+        inline uint32_t size() const;
+
+      private:
+        void work(uint32_t threadId);
+
+        std::vector<std::thread> m_threads;
+
+        std::mutex              m_mutex;
+        std::condition_variable m_condition;
+        std::queue<Task>        m_tasks;
+        bool                    m_stop = false;
+    };
+} // namespace vzt
+
+#include "vzt/core/thread_pool.inl"
+
+#endif // VZT_CORE_THREAD_POOL_HPP
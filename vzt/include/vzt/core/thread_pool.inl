@@ -0,0 +1,6 @@
+#include "vzt/core/thread_pool.hpp"
+
+namespace vzt
+{
+    inline uint32_t ThreadPool::size() const { return static_cast<uint32_t>(m_threads.size()); }
+} // namespace vzt
@@ -0,0 +1,82 @@
+#ifndef VZT_UTILS_PROFILER_HPP
+#define VZT_UTILS_PROFILER_HPP
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "vzt/vulkan/command.hpp"
+#include "vzt/vulkan/query_pool.hpp"
+
+namespace vzt
+{
+    // Statistics in milliseconds over the last recorded samples
+    struct TimingStatistics
+    {
+        float    last     = 0.f;
+        float    min      = 0.f;
+        float    average  = 0.f;
+        float    max      = 0.f;
+        float    p50      = 0.f;
+        float    p95      = 0.f;
+        float    p99      = 0.f;
+        uint32_t sampleNb = 0;
+    };
+
+    // GPU timestamps of named scopes, with one query pool per frame in flight. Results of a frame are read when its
+    // slot is reused by begin(), once the caller waited for the previous submission of this slot, and are dropped
+    // instead of stalling if they are still not available.
+    class GpuProfiler
+    {
+      public:
+        GpuProfiler() = default;
+        GpuProfiler(View<Device> device, uint32_t frameNb, uint32_t maxScopeNb, uint32_t historySize = 256);
+
+        GpuProfiler(const GpuProfiler&)            = delete;
+        GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+        GpuProfiler(GpuProfiler&&) noexcept            = default;
+        GpuProfiler& operator=(GpuProfiler&&) noexcept = default;
+
+        ~GpuProfiler() = default;
+
+        // Collects the results of the previous use of the slot frameId and resets its queries
+        void begin(uint32_t frameId, CommandBuffer& commands);
+        void beginScope(std::string_view name, CommandBuffer& commands);
+        void endScope(CommandBuffer& commands);
+
+        Optional<TimingStatistics>      getStatistics(std::string_view name) const;
+        inline std::vector<std::string> getScopeNames() const;
+
+      private:
+        void collect(uint32_t frameId);
+
+        struct Frame
+        {
+            QueryPool                pool;
+            std::vector<std::string> scopes; // [scopeId], queries [scopeId * 2, scopeId * 2 + 1]
+            std::vector<uint32_t>    opened;
+            bool                     pending = false;
+        };
+
+        struct History
+        {
+            std::vector<float> samples;
+            std::size_t        next = 0;
+            float              last = 0.f;
+        };
+
+        uint32_t           m_maxScopeNb  = 0;
+        uint32_t           m_historySize = 0;
+        float              m_period      = 1.f; // Nanoseconds per timestamp tick
+        uint32_t           m_current     = 0;
+        std::vector<Frame> m_frames;            // [frameId]
+
+        std::unordered_map<std::string, History> m_histories;
+    };
+} // namespace vzt
+
+#include "vzt/profiler.inl"
+
+#endif // VZT_UTILS_PROFILER_HPP
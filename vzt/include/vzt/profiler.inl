@@ -0,0 +1,14 @@
+#include "vzt/profiler.hpp"
+
+namespace vzt
+{
+    inline std::vector<std::string> GpuProfiler::getScopeNames() const
+    {
+        std::vector<std::string> names{};
+        names.reserve(m_histories.size());
+        for (const auto& [name, history] : m_histories)
+            names.emplace_back(name);
+
+        return names;
+    }
+} // namespace vzt
@@ -7,11 +7,16 @@
 #include <string>
 #include <unordered_set>
 
+#include "vzt/core/thread_pool.hpp"
+#include "vzt/profiler.hpp"
 #include "vzt/vulkan/buffer.hpp"
 #include "vzt/vulkan/command.hpp"
 #include "vzt/vulkan/device.hpp"
+#include "vzt/vulkan/memory.hpp"
 #include "vzt/vulkan/pipeline.hpp"
+#include "vzt/vulkan/pipeline/async_compiler.hpp"
 #include "vzt/vulkan/program.hpp"
+#include "vzt/vulkan/semaphore.hpp"
 
 namespace vzt
 {
@@ -38,6 +43,9 @@ namespace vzt
         SharingMode        sharingMode = SharingMode::Exclusive;
         ImageTiling        tiling      = ImageTiling::Optimal;
         bool               mappable    = false;
+
+        // Allows sharing memory with resources whose lifetime does not overlap
+        bool transient = true;
     };
 
     struct StorageBuilder
@@ -47,6 +55,9 @@ namespace vzt
         MemoryLocation location = MemoryLocation::Device;
         bool           mappable = false;
 
+        // Allows sharing memory with resources whose lifetime does not overlap
+        bool transient = true;
+
         template <class Type>
         static StorageBuilder fromType( //
             BufferUsage usage, MemoryLocation location = MemoryLocation::Device, bool mappable = false);
@@ -111,6 +122,22 @@ namespace vzt
         Compute  = toUnderlying(QueueType::Compute)
     };
 
+    // Synchronization required before a pass accesses a resource, derived from its previous accesses in the graph
+    struct PassBarrier
+    {
+        Handle        handle;
+        PipelineStage srcStage  = PipelineStage::None;
+        Access        srcAccess = Access::None;
+        PipelineStage dstStage  = PipelineStage::None;
+        Access        dstAccess = Access::None;
+        ImageLayout   oldLayout = ImageLayout::Undefined;
+        ImageLayout   newLayout = ImageLayout::Undefined;
+
+        // Ownership transfer between queue families, ignored when unset
+        View<Queue> srcQueue = {};
+        View<Queue> dstQueue = {};
+    };
+
     class RenderGraph;
     class Pass
     {
@@ -142,7 +169,15 @@ namespace vzt
         virtual bool isDependingOn(const Pass& other) const;
         void         record(uint32_t i, CommandBuffer& commands) const;
 
-        inline std::string_view getName() const;
+        inline std::string_view   getName() const;
+        inline CSpan<PassBarrier> getBarriers() const;
+
+        // Recorded and submitted on the dedicated compute queue by RenderGraph::submitAsync
+        inline bool isAsync() const;
+
+        // False while the pipeline of the pass is created in the background. The pass is then recorded with its
+        // fallback pipeline if it has one, its barriers alone being recorded otherwise.
+        inline bool isReady() const;
 
         inline DescriptorLayout& getDescriptorLayout();
         inline DescriptorPool&   getDescriptorPool();
@@ -156,13 +191,24 @@ namespace vzt
         virtual void compile();
         virtual void resize();
 
-        void createDescriptors();
+        // Retrieves pipelines created in the background once available, without blocking
+        virtual void poll();
+
+        void          createViews();
+        void          createDescriptors();
+        void          createBarriers();
+        PipelineStage getShaderStages() const;
 
         RenderGraph*     m_graph;
         std::string      m_name;
         PassType         m_type;
+        bool             m_async = false;
         DescriptorLayout m_descriptorLayout;
 
+        bool        m_ready       = true;
+        bool        m_hasFallback = false;
+        std::size_t m_order       = 0; // Order of addition to the graph
+
         std::unique_ptr<RecordHandler> m_recordCallback;
 
         struct PassAttachment
@@ -173,11 +219,10 @@ namespace vzt
 
             uint32_t binding = ~0u;
 
-            Access        waitAccess   = Access::None;
-            Access        targetAccess = Access::None;
-            PipelineStage waitStage    = PipelineStage::None;
-            PipelineStage targetStage  = PipelineStage::None;
-            ImageAspect   aspect       = ImageAspect::Color;
+            // How the pass accesses the attachment
+            Access        access = Access::None;
+            PipelineStage stage  = PipelineStage::None;
+            ImageAspect   aspect = ImageAspect::Color;
 
             ColorBlend blend = {.blendEnable = false};
 
@@ -190,10 +235,9 @@ namespace vzt
             std::string       name;
             Optional<Range<>> range;
 
-            Access        waitAccess;
-            Access        targetAccess;
-            PipelineStage waitStage;
-            PipelineStage targetStage;
+            // How the pass accesses the storage
+            Access        access = Access::None;
+            PipelineStage stage  = PipelineStage::None;
 
             uint32_t binding = ~0u;
 
@@ -214,6 +258,19 @@ namespace vzt
         Optional<PassAttachment> m_depthInput;
         Optional<PassAttachment> m_depthOutput;
 
+        // First use of resources placed on memory previously used by other resources
+        struct PassAliasing
+        {
+            Handle      handle;
+            ImageLayout layout = ImageLayout::Undefined;
+        };
+        std::vector<PassAliasing> m_aliasingBarriers;
+
+        std::vector<PassBarrier> m_barriers;
+
+        // Merged barriers emitted before recording the pass, [backbufferId]
+        std::vector<PipelineBarrier> m_pipelineBarriers;
+
         // Descriptor data
         DescriptorPool         m_pool;
         std::vector<Texture>   m_textureSaves;
@@ -235,6 +292,11 @@ namespace vzt
 
         ~ComputePass() override = default;
 
+        // Used while the pipeline of the pass is not ready. Its bindings must be identical to the ones of the pass
+        // program since both pipelines are bound with the descriptor sets of the pass.
+        void setFallback(Program&& program);
+
+        // Returns the fallback pipeline while the pass is not ready
         inline ComputePipeline& getPipeline();
 
         friend RenderGraph;
@@ -242,9 +304,14 @@ namespace vzt
       private:
         ComputePass(RenderGraph& graph, std::string name, Program&& program);
         void compile() override;
+        void poll() override;
 
         Program         m_program;
         ComputePipeline m_pipeline;
+
+        std::future<ComputePipeline> m_pendingPipeline;
+        Program                      m_fallbackProgram;
+        ComputePipeline              m_fallbackPipeline;
     };
 
     class GraphicsPass : public Pass
@@ -267,6 +334,11 @@ namespace vzt
         void addColorInputOutput(Handle& attachment, std::string inName = "", std::string outName = "",
                                  ColorBlend blend = {.blendEnable = false});
 
+        // Built with the same configuration as the pass pipeline and used while it is not ready. Its bindings must
+        // be identical to the ones of the pass program since both pipelines are bound with the pass descriptor sets.
+        void setFallback(Program&& program);
+
+        // Returns the fallback pipeline while the pass is not ready
         inline GraphicsPipeline&        getPipeline();
         inline GraphicsPipelineBuilder& getBuilder();
 
@@ -276,10 +348,23 @@ namespace vzt
         GraphicsPass(RenderGraph& graph, std::string name, Program&& program);
         void compile() override;
         void resize() override;
+        void poll() override;
 
         Program                 m_program;
         GraphicsPipelineBuilder m_graphicsPipelineBuilder;
         GraphicsPipeline        m_pipeline;
+
+        std::future<GraphicsPipeline> m_pendingPipeline;
+        Program                       m_fallbackProgram;
+        GraphicsPipeline              m_fallbackPipeline;
+    };
+
+    // Memory owned by a graph, to compare with Device::getMemoryStatistics() across compilations
+    struct GraphMemoryFootprint
+    {
+        uint64_t requested    = 0; // Without aliasing
+        uint64_t allocated    = 0;
+        uint32_t allocationNb = 0; // Memory blocks and resources with their own allocation
     };
 
     class RenderGraph
@@ -295,6 +380,36 @@ namespace vzt
         Handle addAttachment(AttachmentBuilder builder);
         Handle addStorage(StorageBuilder builder);
 
+        // Passes which contribute neither to the backbuffer, nor to exported or host visible resources, are culled
+        // at compilation when enabled (default), as well as the resources they only use.
+        inline void setCulling(bool enabled);
+        void        exportHandle(const Handle& handle);
+
+        // Transient resources with non-overlapping lifetimes share memory when enabled (default)
+        inline void setMemoryAliasing(bool enabled);
+
+        // Compute passes independent of previous graphics work run on the dedicated compute queue when the device
+        // has one and when enabled (default: disabled). They are then only executed by submitAsync(), which must be
+        // called each frame.
+        inline void setAsyncCompute(bool enabled);
+
+        // Passes are recorded by threadNb threads into secondary command buffers when threadNb > 1 (default: 1).
+        // Record functions of different passes are then called concurrently. Must be set before compile().
+        inline void setRecordThreadNb(uint32_t threadNb);
+
+        // GPU time of each pass recorded by record() and of the whole graph (ProfilerScope) is measured when enabled
+        // (default: disabled). Async passes are not measured. Must be set before compile().
+        inline void                       setProfiling(bool enabled);
+        inline const GpuProfiler&         getProfiler() const;
+        static constexpr std::string_view ProfilerScope = "RenderGraph";
+
+        // Pipelines are created by threadNb background threads when enabled (default: disabled) so that compile()
+        // does not block on them. Passes report whether their pipeline is ready. Must be set before compile().
+        inline void setAsyncPipelines(bool enabled, uint32_t threadNb = std::thread::hardware_concurrency());
+
+        // True once the pipelines of all passes are created
+        bool isReady() const;
+
         ComputePass&  addCompute(std::string name, Program&& program);
         ComputePass&  addCompute(std::string name, std::vector<Shader> shaders);
         ComputePass&  addCompute(std::string name, Shader shader);
@@ -311,6 +426,11 @@ namespace vzt
         void record(uint32_t i, CommandBuffer& commands);
         void resize(const Extent2D& extent);
 
+        // Records and submits async passes of the backbuffer i. The returned waits must be given to the submission
+        // of the commands recorded with record(), they are empty if no pass is async.
+        std::vector<SemaphoreWait> submitAsync(uint32_t i);
+
+        // Passes in execution order, culled passes excluded
         inline std::unique_ptr<Pass>&       operator[](uint32_t passId);
         inline const std::unique_ptr<Pass>& operator[](uint32_t passId) const;
         inline uint32_t                     size() const;
@@ -325,6 +445,8 @@ namespace vzt
         inline uint32_t     getBackbufferNb() const;
         inline View<Device> getDevice() const;
 
+        inline GraphMemoryFootprint getMemoryFootprint() const;
+
         inline void  setUserData(void* userData);
         inline void* getUserData() const;
 
@@ -337,9 +459,31 @@ namespace vzt
         Handle generateStorageHandle() const;
 
         const AttachmentBuilder& getConfiguration(Handle handle);
+        bool                     isOutput(const Handle& handle) const;
+
+        struct ResourceLifetime
+        {
+            std::size_t first;
+            std::size_t last;
+            bool        preserved; // First access reads previous content
+            ImageLayout layout;    // Layout of the first access
+            bool        async = false;
+        };
+        HandleMap<ResourceLifetime> getLifetimes() const;
 
-        std::vector<std::size_t> sort();
-        void                     createRenderTarget();
+        PipelineBarrier getPipelineBarrier(uint32_t backbufferId, CSpan<PassBarrier> barriers) const;
+
+        // Passes each pass depends on, [passId]
+        std::vector<std::vector<std::size_t>> getDependencies() const;
+        void                                  cull();
+        std::vector<std::size_t>              sort();
+
+        View<Queue> getAsyncQueue() const;
+        void        trackHazards();
+        void        createRenderTarget(bool extentOnly = false);
+        void        createAsyncSubmissions();
+        void        createRecordPools();
+        void        pollPipelines();
 
         static inline std::atomic<std::size_t> m_handleCounter = 0;
 
@@ -352,8 +496,39 @@ namespace vzt
         HandleMap<std::size_t>             m_handleToPhysical;
         std::vector<std::unique_ptr<Pass>> m_passes;
 
-        std::vector<DeviceImage> m_images;   // [imageId  ]
-        std::vector<Buffer>      m_storages; // [storageId]
+        bool                               m_culling = true;
+        std::vector<Handle>                m_exports;
+        std::vector<std::unique_ptr<Pass>> m_culledPasses; // Kept alive for user references, reconsidered by compile()
+
+        bool                      m_aliasing = true;
+        GraphMemoryFootprint      m_footprint;
+        std::vector<DeviceMemory> m_memory;       // [blockId * backbufferNb + backbufferId], must outlive resources
+        std::vector<DeviceMemory> m_extentMemory; // Same for resources whose size depends on the backbuffer extent
+        std::vector<DeviceImage>  m_images;       // [imageId  ]
+        std::vector<Buffer>       m_storages;     // [storageId]
+
+        // Requirements of fixed size resources, which are only queried again on compilation
+        HandleMap<MemoryRequirements> m_memoryRequirements;
+
+        bool                         m_asyncCompute   = false;
+        View<Queue>                  m_asyncQueue;
+        PipelineStage                m_asyncWaitStage = PipelineStage::None;
+        std::vector<PassBarrier>     m_releaseBarriers; // Ownership transfers from the compute queue
+        std::vector<PipelineBarrier> m_asyncReleases;   // [backbufferId]
+        std::vector<Semaphore>       m_asyncSemaphores; // [backbufferId]
+        CommandPool                  m_asyncCommandPool;
+
+        uint32_t                    m_recordThreadNb = 1;
+        std::unique_ptr<ThreadPool> m_recordThreads;
+        std::vector<CommandPool>    m_recordPools; // [threadId], buffers [backbufferId * passNb + passId]
+
+        bool        m_profiling = false;
+        GpuProfiler m_profiler;
+
+        // Destroyed before the passes whose programs are referenced by pending compilations
+        bool                                   m_asyncPipelines           = false;
+        uint32_t                               m_pipelineCompilerThreadNb = 1;
+        std::unique_ptr<AsyncPipelineCompiler> m_pipelineCompiler;
 
         Optional<Handle> m_backbuffer;
         uint32_t         m_backbufferNb = 1;
@@ -361,8 +536,15 @@ namespace vzt
         Extent2D         m_backbufferExtent;
         ImageLayout      m_backbufferLayout;
 
+        View<Swapchain>                m_swapchain;
         std::vector<View<DeviceImage>> m_externalBackbuffers;
 
+        // Layout in which the graph leaves attachments preserved across frames
+        HandleMap<ImageLayout> m_preservedLayouts;
+
+        // Resources recreated by the last call to createRenderTarget
+        std::unordered_set<Handle, Handle::hash> m_reallocated;
+
         void* m_userData = nullptr;
     };
 } // namespace vzt
@@ -16,9 +16,12 @@ namespace vzt
         m_recordCallback = std::make_unique<DerivedHandler>(std::forward<Args>(args)...);
     }
 
-    inline std::string_view  Pass::getName() const { return m_name; }
-    inline DescriptorLayout& Pass::getDescriptorLayout() { return m_descriptorLayout; }
-    inline DescriptorPool&   Pass::getDescriptorPool() { return m_pool; }
+    inline std::string_view   Pass::getName() const { return m_name; }
+    inline CSpan<PassBarrier> Pass::getBarriers() const { return m_barriers; }
+    inline bool               Pass::isAsync() const { return m_async; }
+    inline bool               Pass::isReady() const { return m_ready; }
+    inline DescriptorLayout&  Pass::getDescriptorLayout() { return m_descriptorLayout; }
+    inline DescriptorPool&    Pass::getDescriptorPool() { return m_pool; }
 
     inline CSpan<ImageView> Pass::getColorOutputs(uint32_t b) const
     {
@@ -38,8 +41,8 @@ namespace vzt
         return m_depthOutputImageViews[b];
     }
 
-    inline ComputePipeline&         ComputePass::getPipeline() { return m_pipeline; }
-    inline GraphicsPipeline&        GraphicsPass::getPipeline() { return m_pipeline; }
+    inline ComputePipeline&         ComputePass::getPipeline() { return m_ready ? m_pipeline : m_fallbackPipeline; }
+    inline GraphicsPipeline&        GraphicsPass::getPipeline() { return m_ready ? m_pipeline : m_fallbackPipeline; }
     inline GraphicsPipelineBuilder& GraphicsPass::getBuilder() { return m_graphicsPipelineBuilder; }
 
     inline std::unique_ptr<Pass>&       RenderGraph::operator[](uint32_t passId) { return m_passes[passId]; }
@@ -50,11 +53,26 @@ namespace vzt
     inline std::vector<std::unique_ptr<Pass>>::const_iterator RenderGraph::begin() const { return m_passes.begin(); }
     inline std::vector<std::unique_ptr<Pass>>::const_iterator RenderGraph::end() const { return m_passes.end(); }
 
+    inline void RenderGraph::setCulling(bool enabled) { m_culling = enabled; }
+    inline void RenderGraph::setMemoryAliasing(bool enabled) { m_aliasing = enabled; }
+    inline void RenderGraph::setAsyncCompute(bool enabled) { m_asyncCompute = enabled; }
+    inline void RenderGraph::setRecordThreadNb(uint32_t threadNb) { m_recordThreadNb = threadNb; }
+    inline void RenderGraph::setProfiling(bool enabled) { m_profiling = enabled; }
+    inline void RenderGraph::setAsyncPipelines(bool enabled, uint32_t threadNb)
+    {
+        m_asyncPipelines           = enabled;
+        m_pipelineCompilerThreadNb = threadNb;
+    }
+
+    inline const GpuProfiler& RenderGraph::getProfiler() const { return m_profiler; }
+
     inline Format       RenderGraph::getBackbufferFormat() const { return m_backbufferFormat; }
     inline Extent2D     RenderGraph::getBackbufferExtent() const { return m_backbufferExtent; }
     inline uint32_t     RenderGraph::getBackbufferNb() const { return m_backbufferNb; }
     inline View<Device> RenderGraph::getDevice() const { return m_device; }
 
+    inline GraphMemoryFootprint RenderGraph::getMemoryFootprint() const { return m_footprint; }
+
     inline void  RenderGraph::setUserData(void* userData) { m_userData = userData; }
     inline void* RenderGraph::getUserData() const { return m_userData; }
 } // namespace vzt
@@ -3,6 +3,7 @@
 
 #include "vzt/core/type.hpp"
 #include "vzt/vulkan/device.hpp"
+#include "vzt/vulkan/memory.hpp"
 #include "vzt/vulkan/setup.hpp"
 
 namespace vzt
@@ -10,6 +11,9 @@ namespace vzt
     class Device;
     class Queue;
 
+    // Identifies a batch of uploads, which is complete once the timeline of the upload manager reaches this value
+    using UploadToken = uint64_t;
+
     enum class MemoryLocation
     {
         Host,
@@ -25,10 +29,22 @@ namespace vzt
         static Buffer From(View<Device> device, CSpan<uint8_t> data, BufferUsage usages,
                            MemoryLocation location = MemoryLocation::Device, bool mappable = false);
 
+        // Does not wait for the upload, token is 0 when the data could be written directly and is otherwise to be
+        // waited on the upload manager of the device before using the buffer.
+        template <class Type>
+        static Buffer FromAsync(View<Device> device, CSpan<Type> data, BufferUsage usages, UploadToken& token,
+                                MemoryLocation location = MemoryLocation::Device);
+        static Buffer FromAsync(View<Device> device, CSpan<uint8_t> data, BufferUsage usages, UploadToken& token,
+                                MemoryLocation location = MemoryLocation::Device);
+
         Buffer() = default;
         Buffer(View<Device> device, std::size_t byteNb, BufferUsage usages,
                MemoryLocation location = MemoryLocation::Device, bool mappable = false);
 
+        // Places the buffer on an existing memory block, which is not owned by the buffer.
+        Buffer(View<Device> device, std::size_t byteNb, BufferUsage usages, const DeviceMemory& memory,
+               uint64_t offset = 0);
+
         Buffer(const Buffer&)            = delete;
         Buffer& operator=(const Buffer&) = delete;
 
@@ -37,22 +53,49 @@ namespace vzt
 
         ~Buffer() override;
 
+        // Mappable buffers are persistently mapped: map() returns the same pointer for their whole lifetime and unMap()
+        // only flushes host writes.
         uint8_t* map() const;
         void     unMap() const;
 
+        // Required around host accesses when the memory is not host coherent, no-op otherwise
+        void flush(uint64_t offset = 0, uint64_t size = VK_WHOLE_SIZE) const;
+        void invalidate(uint64_t offset = 0, uint64_t size = VK_WHOLE_SIZE) const;
+
         // Requires dext::BufferDeviceAddress
         uint64_t getDeviceAddress() const;
 
+        static MemoryRequirements getMemoryRequirements(View<Device> device, std::size_t byteNb, BufferUsage usages);
+
+        // Movable buffers can be relocated by a Defragmenter, which replaces their handle. Only non-mapped buffers
+        // with their own allocation and BufferUsage::TransferSrc can be movable. They must not be written by the GPU
+        // while a defragmentation pass is running.
+        void setMovable(bool movable);
+
         inline bool           isMappable() const;
+        inline bool           isAliased() const;
+        inline bool           isMovable() const;
         inline std::size_t    size() const;
         inline MemoryLocation getLocation() const;
+        inline BufferUsage    getUsages() const;
 
       private:
+        friend class Defragmenter;
+
+        Buffer(View<Device> device, std::size_t byteNb, BufferUsage usages, MemoryLocation location, bool mappable,
+               VmaAllocationCreateFlags flags);
+
+        // Allocations of movable buffers reference their owner, which changes when they are moved
+        void updateOwner();
+
         VmaAllocation  m_allocation = VK_NULL_HANDLE;
+        uint8_t*       m_mapped     = nullptr;
         std::size_t    m_size       = 0;
         MemoryLocation m_location   = MemoryLocation::Host;
         BufferUsage    m_usages     = BufferUsage::None;
         bool           m_mappable   = false;
+        bool           m_aliased    = false;
+        bool           m_movable    = false;
     };
 
     struct BufferSpan
@@ -10,7 +10,18 @@ namespace vzt
         return From(device, translated, usages, location, mappable);
     }
 
+    template <class Type>
+    Buffer Buffer::FromAsync(View<Device> device, CSpan<Type> data, BufferUsage usages, UploadToken& token,
+                             MemoryLocation location)
+    {
+        const CSpan<uint8_t> translated = {reinterpret_cast<const uint8_t*>(data.data), data.size * sizeof(Type)};
+        return FromAsync(device, translated, usages, token, location);
+    }
+
     inline bool           Buffer::isMappable() const { return m_mappable; }
+    inline bool           Buffer::isAliased() const { return m_aliased; }
+    inline bool           Buffer::isMovable() const { return m_movable; }
     inline std::size_t    Buffer::size() const { return m_size; }
     inline MemoryLocation Buffer::getLocation() const { return m_location; }
+    inline BufferUsage    Buffer::getUsages() const { return m_usages; }
 } // namespace vzt
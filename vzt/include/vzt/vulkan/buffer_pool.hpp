@@ -0,0 +1,70 @@
+#ifndef VZT_VULKAN_BUFFER_POOL_HPP
+#define VZT_VULKAN_BUFFER_POOL_HPP
+
+#include <deque>
+
+#include "vzt/vulkan/buffer.hpp"
+
+namespace vzt
+{
+    struct BufferAllocation
+    {
+        BufferSpan           span;
+        uint32_t             blockId    = 0;
+        VmaVirtualAllocation allocation = VK_NULL_HANDLE;
+    };
+
+    // Sub-allocates ranges of large buffers sharing the same usages. Free ranges of each block are managed by a VMA
+    // virtual block (TLSF), and requests larger than the block size get a dedicated block. Not thread safe.
+    class BufferPool
+    {
+      public:
+        static constexpr std::size_t DefaultBlockByteNb = 32ull * 1024ull * 1024ull;
+
+        BufferPool() = default;
+        BufferPool(View<Device> device, BufferUsage usages, std::size_t blockByteNb = DefaultBlockByteNb,
+                   MemoryLocation location = MemoryLocation::Device, bool mappable = false);
+
+        BufferPool(const BufferPool&)            = delete;
+        BufferPool& operator=(const BufferPool&) = delete;
+
+        BufferPool(BufferPool&& other) noexcept;
+        BufferPool& operator=(BufferPool&& other) noexcept;
+
+        ~BufferPool();
+
+        // Alignment must be a power of two
+        BufferAllocation allocate(std::size_t byteNb, std::size_t alignment = 16);
+        template <class Type>
+        BufferAllocation allocate(std::size_t count, std::size_t alignment = 16);
+
+        void free(const BufferAllocation& allocation);
+
+        // Releases all allocations while keeping the blocks
+        void clear();
+
+        inline std::size_t   getBlockNb() const;
+        inline const Buffer& getBlock(uint32_t blockId) const;
+        inline BufferUsage   getUsages() const;
+
+      private:
+        uint32_t addBlock(std::size_t byteNb);
+
+        struct Block
+        {
+            Buffer          buffer;
+            VmaVirtualBlock allocator = VK_NULL_HANDLE;
+        };
+
+        View<Device>      m_device;
+        BufferUsage       m_usages      = BufferUsage::None;
+        std::size_t       m_blockByteNb = 0;
+        MemoryLocation    m_location    = MemoryLocation::Device;
+        bool              m_mappable    = false;
+        std::deque<Block> m_blocks; // Stable addresses, spans point to the buffers of the blocks
+    };
+} // namespace vzt
+
+#include "vzt/vulkan/buffer_pool.inl"
+
+#endif // VZT_VULKAN_BUFFER_POOL_HPP
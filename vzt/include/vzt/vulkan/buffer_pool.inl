@@ -0,0 +1,14 @@
+#include "vzt/vulkan/buffer_pool.hpp"
+
+namespace vzt
+{
+    template <class Type>
+    BufferAllocation BufferPool::allocate(std::size_t count, std::size_t alignment)
+    {
+        return allocate(count * sizeof(Type), alignment);
+    }
+
+    inline std::size_t   BufferPool::getBlockNb() const { return m_blocks.size(); }
+    inline const Buffer& BufferPool::getBlock(uint32_t blockId) const { return m_blocks[blockId].buffer; }
+    inline BufferUsage   BufferPool::getUsages() const { return m_usages; }
+} // namespace vzt
@@ -50,6 +50,10 @@ namespace vzt
         Access      dst;
         View<Queue> srcQueue = {};
         View<Queue> dstQueue = {};
+
+        // Stages of this barrier only, used with Synchronization2. PipelineBarrier stages are used when None.
+        PipelineStage srcStage = PipelineStage::None;
+        PipelineStage dstStage = PipelineStage::None;
     };
 
     struct ImageBarrier
@@ -64,6 +68,10 @@ namespace vzt
         uint32_t          baseLevel  = 0;
         uint32_t          levelCount = 1;
         ImageAspect       aspect     = ImageAspect::Color;
+
+        // Stages of this barrier only, used with Synchronization2. PipelineBarrier stages are used when None.
+        PipelineStage srcStage = PipelineStage::None;
+        PipelineStage dstStage = PipelineStage::None;
     };
 
     struct PipelineBarrier
@@ -127,20 +135,30 @@ namespace vzt
                   Filter filter = Filter::Linear);
         void blit(View<DeviceImage> src, ImageLayout srcLayout, View<DeviceImage> dst, ImageLayout dstLayout,
                   Filter filter, const Blit& blit);
+
+        // Fills levels [1, mipLevels) by a cascade of blits from level 0, every level being in TransferDstOptimal.
+        // All levels end in finalLayout. Requires a queue supporting graphics operations. Levels are left untouched
+        // when the format does not support blits, and filtered with Filter::Nearest when it does not support linear
+        // filtering.
+        void generateMipmaps(View<DeviceImage> image, ImageLayout finalLayout = ImageLayout::ShaderReadOnlyOptimal);
+
         void copy(View<Buffer> src, View<Buffer> dst, uint64_t size, uint64_t srcOffset = 0, uint64_t dstOffset = 0);
         void copy(View<Buffer> src, View<DeviceImage> dst, uint32_t width, uint32_t height,
-                  ImageAspect aspect = ImageAspect::Color);
+                  ImageAspect aspect = ImageAspect::Color, uint64_t srcOffset = 0);
         void copy(View<DeviceImage> src, View<DeviceImage> dst, uint32_t width, uint32_t height,
                   ImageAspect aspect = ImageAspect::Color);
 
         void bind(const GraphicsPipeline& graphicPipeline);
-        void bind(const GraphicsPipeline& graphicPipeline, const DescriptorSet& set);
+        void bind(const GraphicsPipeline& graphicPipeline, const DescriptorSet& set,
+                  CSpan<uint32_t> dynamicOffsets = {});
         void bind(const ComputePipeline& computePipeline);
-        void bind(const ComputePipeline& computePipeline, const DescriptorSet& set);
+        void bind(const ComputePipeline& computePipeline, const DescriptorSet& set,
+                  CSpan<uint32_t> dynamicOffsets = {});
         void bind(const RaytracingPipeline& raytracingPipeline);
-        void bind(const RaytracingPipeline& raytracingPipeline, const DescriptorSet& set);
-        void bindVertexBuffer(const Buffer& buffer);
-        void bindIndexBuffer(const Buffer& buffer, std::size_t index);
+        void bind(const RaytracingPipeline& raytracingPipeline, const DescriptorSet& set,
+                  CSpan<uint32_t> dynamicOffsets = {});
+        void bindVertexBuffer(const BufferCSpan& buffer);
+        void bindIndexBuffer(const BufferCSpan& buffer, std::size_t index);
 
         void pushConstants(const Pipeline& pipeline, ShaderStage stages, uint32_t offset, uint32_t size,
                            const uint8_t* data);
@@ -151,7 +169,7 @@ namespace vzt
         void dispatch(uint32_t x, uint32_t y = 1, uint32_t z = 1);
         void draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t vertexOffset = 0,
                   uint32_t instanceOffset = 0);
-        void drawIndexed(const Buffer& indexBuffer, const Range<>& range, uint32_t instanceCount = 1,
+        void drawIndexed(const BufferCSpan& indexBuffer, const Range<>& range, uint32_t instanceCount = 1,
                          int32_t vertexOffset = 0, uint32_t instanceOffset = 0);
 
         void drawIndirect(const BufferCSpan& buffer, uint32_t drawCount, uint32_t stride);
@@ -170,17 +188,24 @@ namespace vzt
         void beginRendering(const RenderingInfo& info);
         void endRendering();
 
+        // Executes secondary command buffers, which must be recorded outside of any rendering scope
+        void execute(CSpan<CommandBuffer> secondaries);
+
         void buildAs(AccelerationStructureBuilder& builder);
 
       private:
-        CommandBuffer(View<Device> m_device, VkCommandBuffer handle);
+        CommandBuffer(View<Device> m_device, VkCommandBuffer handle,
+                      CommandBufferLevel level = CommandBufferLevel::Primary);
+
+        CommandBufferLevel m_level;
     };
 
     class CommandPool : public DeviceObject<VkCommandPool>
     {
       public:
         CommandPool() = default;
-        CommandPool(View<Device> device, View<Queue> queue, uint32_t bufferNb = 1);
+        CommandPool(View<Device> device, View<Queue> queue, uint32_t bufferNb = 1,
+                    CommandBufferLevel level = CommandBufferLevel::Primary);
 
         CommandPool(CommandPool&)                  = delete;
         CommandPool& operator=(const CommandPool&) = delete;
@@ -195,6 +220,7 @@ namespace vzt
 
       private:
         View<Queue>                  m_queue;
+        CommandBufferLevel           m_level = CommandBufferLevel::Primary;
         std::vector<VkCommandBuffer> m_commandBuffers;
     };
 } // namespace vzt
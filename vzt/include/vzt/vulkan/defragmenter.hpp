@@ -0,0 +1,94 @@
+#ifndef VZT_VULKAN_DEFRAGMENTER_HPP
+#define VZT_VULKAN_DEFRAGMENTER_HPP
+
+#include <functional>
+#include <vector>
+
+#include "vzt/vulkan/buffer.hpp"
+#include "vzt/vulkan/command.hpp"
+#include "vzt/vulkan/semaphore.hpp"
+
+namespace vzt
+{
+    // Incrementally compacts the default VMA pools over several frames. Each pass copies movable buffers (see
+    // Buffer::setMovable) on the transfer queue, replaces their handle once the copy is complete and notifies the
+    // callback so that descriptors referencing them can be updated. Previous handles and memory are released frameNb
+    // updates later, once no frame in flight can use them anymore. Other allocations are never moved, and movable
+    // buffers must outlive the passes they are part of.
+    // Each pass waits for the device to be idle before its copy. Movable buffers must however not be written by the
+    // GPU while a pass is copying them (see isRunning), since such writes would be lost when their handle is replaced.
+    class Defragmenter
+    {
+      public:
+        static constexpr uint64_t DefaultMaxBytesPerPass = 64ull * 1024ull * 1024ull;
+
+        using MoveCallback = std::function<void(const Buffer& buffer)>;
+
+        Defragmenter(View<Device> device, uint32_t frameNb, uint64_t maxBytesPerPass = DefaultMaxBytesPerPass,
+                     uint32_t maxMovesPerPass = 256);
+
+        Defragmenter(const Defragmenter&)            = delete;
+        Defragmenter& operator=(const Defragmenter&) = delete;
+
+        Defragmenter(Defragmenter&&)            = delete;
+        Defragmenter& operator=(Defragmenter&&) = delete;
+
+        ~Defragmenter();
+
+        inline void setCallback(MoveCallback callback);
+
+        // Starts a defragmentation if none is running
+        void start();
+
+        // To be called once per frame, after waiting for the previous submission of the frame. Returns true while
+        // the defragmentation is running.
+        bool update();
+
+        inline bool     isRunning() const;
+        inline uint64_t getMovedByteNb() const; // Since start()
+
+      private:
+        void beginPass();
+        void patch();
+        void endPass();
+        void finish();
+
+        enum class State
+        {
+            Idle,
+            Ready,
+            Copying,
+            Retiring
+        };
+
+        struct Move
+        {
+            VmaAllocation allocation;
+            VkBuffer      handle; // New handle while copying, previous one once patched
+            uint64_t      size;
+        };
+
+        View<Device> m_device;
+        View<Queue>  m_queue;
+        uint32_t     m_frameNb;
+        uint64_t     m_maxBytesPerPass;
+        uint32_t     m_maxMovesPerPass;
+
+        CommandPool m_pool;
+        Semaphore   m_timeline;
+        uint64_t    m_value = 0;
+
+        VmaDefragmentationContext      m_context = VK_NULL_HANDLE;
+        VmaDefragmentationPassMoveInfo m_pass{};
+        State                          m_state          = State::Idle;
+        uint32_t                       m_retiringFrames = 0;
+        std::vector<Move>              m_moves;
+        uint64_t                       m_movedByteNb = 0;
+
+        MoveCallback m_callback;
+    };
+} // namespace vzt
+
+#include "vzt/vulkan/defragmenter.inl"
+
+#endif // VZT_VULKAN_DEFRAGMENTER_HPP
@@ -0,0 +1,8 @@
+#include "vzt/vulkan/defragmenter.hpp"
+
+namespace vzt
+{
+    inline void     Defragmenter::setCallback(MoveCallback callback) { m_callback = std::move(callback); }
+    inline bool     Defragmenter::isRunning() const { return m_state != State::Idle; }
+    inline uint64_t Defragmenter::getMovedByteNb() const { return m_movedByteNb; }
+} // namespace vzt
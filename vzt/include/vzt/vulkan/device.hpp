@@ -2,9 +2,13 @@
 #define VZT_VULKAN_DEVICE_HPP
 
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <string>
 #include <vector>
 
+#include "vzt/core/file.hpp"
 #include "vzt/core/type.hpp"
 #include "vzt/vulkan/type.hpp"
 
@@ -47,6 +51,7 @@ namespace vzt
         constexpr Extension PortabilitySubset       = "VK_KHR_portability_subset";
         constexpr Extension NonSemanticInfo         = VK_KHR_SHADER_NON_SEMANTIC_INFO_EXTENSION_NAME;
         constexpr Extension DynamicRendering        = VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME;
+        constexpr Extension Synchronization2        = VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME;
     } // namespace dext
 
     // Based on https://github.com/charles-lunarg/vk-bootstrap/blob/master/src/VkBootstrap.h#L161
@@ -87,6 +92,7 @@ namespace vzt
 
         void                                            add(GenericDeviceFeature feature);
         inline const std::vector<GenericDeviceFeature>& getFeatures() const;
+        inline std::vector<GenericDeviceFeature>&       getFeatures();
         inline const VkPhysicalDeviceFeatures2&         getPhysicalFeatures() const;
         inline VkPhysicalDeviceFeatures2&               getPhysicalFeatures();
         const VkPhysicalDeviceFeatures2&                getAllFeatures() const;
@@ -111,14 +117,24 @@ namespace vzt
         inline void add(QueueType queueType);
         inline void add(dext::Extension extension);
 
+        // Requests a compute queue from a family without graphics support, returned by getQueue(QueueType::Compute)
+        inline void setAsyncCompute(bool enabled);
+
+        // The device pipeline cache is loaded from path and saved back when the device is destroyed
+        inline void setPipelineCachePath(Path path);
+
         inline const DeviceFeatures&               getDeviceFeatures() const;
         inline DeviceFeatures&                     getDeviceFeatures();
         inline QueueType                           getQueueTypes() const;
         inline const std::vector<dext::Extension>& getExtensions() const;
+        inline bool                                hasAsyncCompute() const;
+        inline const Path&                         getPipelineCachePath() const;
 
       private:
         DeviceFeatures m_features;
         QueueType      m_queueTypes;
+        bool           m_asyncCompute = false;
+        Path           m_pipelineCachePath;
 
         std::vector<dext::Extension> m_extensions;
     };
@@ -134,6 +150,9 @@ namespace vzt
         std::vector<VkQueueFamilyProperties> getQueueFamiliesProperties() const;
         bool                                 canQueueFamilyPresent(uint32_t id, View<Surface> surface) const;
         Format                               getDepthFormat() const;
+        bool                                 supportsSynchronization2() const;
+
+        FormatFeature getFormatFeatures(Format format, ImageTiling tiling = ImageTiling::Optimal) const;
 
         std::size_t getUniformAlignment(std::size_t alignment) const;
         template <class Type>
@@ -147,11 +166,36 @@ namespace vzt
         VkPhysicalDeviceProperties m_properties;
     };
 
+    struct MemoryHeapStatistics
+    {
+        uint64_t budget          = 0; // Bytes the process can use before degrading performance
+        uint64_t usage           = 0; // Bytes used by the process, other allocators included
+        uint64_t blockBytes      = 0; // Memory blocks allocated by VMA
+        uint64_t allocationBytes = 0; // Parts of the blocks used by allocations
+        uint32_t blockNb         = 0;
+        uint32_t allocationNb    = 0;
+        float    fragmentation   = 0.f; // 1 - largest free range / free bytes, 0 when free memory is contiguous
+        bool     deviceLocal     = false;
+
+        inline bool isOverBudget() const;
+    };
+
+    struct MemoryStatistics
+    {
+        std::vector<MemoryHeapStatistics> heaps; // [heapId]
+        uint64_t                          blockBytes      = 0;
+        uint64_t                          allocationBytes = 0;
+        uint32_t                          blockNb         = 0;
+        uint32_t                          allocationNb    = 0;
+    };
+
+    class PipelineCache;
     class Queue;
+    class UploadManager;
     class Device
     {
       public:
-        Device() = default;
+        Device();
         Device(View<Instance> instance, PhysicalDevice device, DeviceBuilder configuration = {},
                View<Surface> surface = {});
 
@@ -174,6 +218,27 @@ namespace vzt
         inline VmaAllocator           getAllocator() const;
         inline PhysicalDevice         getHardware() const;
 
+        // Synchronization2 is enabled when supported by the hardware
+        inline bool hasSynchronization2() const;
+
+        // Timeline semaphores are enabled on Vulkan 1.2 devices, where their support is mandatory
+        inline bool hasTimelineSemaphore() const;
+
+        // Staging ring shared by resource uploads, created on first use. Requires timeline semaphores.
+        UploadManager& getUploadManager() const;
+
+        // Budgets are estimated by VMA when VK_EXT_memory_budget is not available
+        MemoryStatistics getMemoryStatistics() const;
+
+        // VMA JSON dump of heaps, blocks and, when detailed, of every allocation
+        std::string getMemoryDump(bool detailed = false) const;
+
+        // Used by every pipeline created with this device
+        inline PipelineCache& getPipelineCache() const;
+
+        // Writes the pipeline cache to the path given by the configuration, if any
+        bool savePipelineCache() const;
+
       private:
         View<Instance>  m_instance;
         PhysicalDevice  m_device;
@@ -183,8 +248,16 @@ namespace vzt
         VmaAllocator  m_allocator = VK_NULL_HANDLE;
         DeviceBuilder m_configuration;
 
+        bool m_synchronization2  = false;
+        bool m_timelineSemaphore = false;
+
         static inline bool                      isSameQueue(const Queue& q1, const Queue& q2);
         std::set<Queue, decltype(&isSameQueue)> m_queues{&isSameQueue};
+
+        mutable std::mutex                     m_uploadMutex;
+        mutable std::unique_ptr<UploadManager> m_uploadManager;
+
+        std::unique_ptr<PipelineCache> m_pipelineCache;
     };
 
     template <class Handle>
@@ -211,6 +284,10 @@ namespace vzt
     };
 
     class CommandBuffer;
+    class Fence;
+    class Semaphore;
+    struct SemaphoreWait;
+    struct SubmissionFuture;
     struct SwapchainSubmission;
     class Queue
     {
@@ -220,9 +297,20 @@ namespace vzt
 
         using SingleTimeCommandFunction = std::function<void(CommandBuffer&)>;
         void oneShot(const SingleTimeCommandFunction& function) const;
-        void submit(const CommandBuffer& commandBuffer, const SwapchainSubmission& submission) const;
+        void submit(const CommandBuffer& commandBuffer, const SwapchainSubmission& submission,
+                    CSpan<SemaphoreWait> waits = {}) const;
         void submit(const CommandBuffer& commandBuffer) const;
 
+        // Does not wait for completion, which must be ensured by a submission waiting for the signaled semaphore
+        void submit(const CommandBuffer& commandBuffer, View<Semaphore> signal) const;
+
+        // Does not wait for completion, the fence is signaled once the commands are executed
+        void submit(const CommandBuffer& commandBuffer, const Fence& fence) const;
+
+        // Does not wait for completion, the timeline semaphore reaches value once the commands are executed
+        SubmissionFuture submit(const CommandBuffer& commandBuffer, const Semaphore& timeline, uint64_t value,
+                                CSpan<SemaphoreWait> waits = {}) const;
+
         inline View<Device> getDevice() const;
         inline VkQueue      getHandle() const;
         inline QueueType    getType() const;
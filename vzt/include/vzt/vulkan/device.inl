@@ -3,17 +3,25 @@
 namespace vzt
 {
     inline const std::vector<GenericDeviceFeature>& DeviceFeatures::getFeatures() const { return m_features; }
+    inline std::vector<GenericDeviceFeature>&       DeviceFeatures::getFeatures() { return m_features; }
     inline const VkPhysicalDeviceFeatures2& DeviceFeatures::getPhysicalFeatures() const { return m_physicalFeatures; }
     inline VkPhysicalDeviceFeatures2&       DeviceFeatures::getPhysicalFeatures() { return m_physicalFeatures; }
 
     inline void DeviceBuilder::set(DeviceFeatures features) { m_features = std::move(features); }
     inline void DeviceBuilder::add(QueueType queueType) { m_queueTypes |= queueType; }
     inline void DeviceBuilder::add(dext::Extension extension) { m_extensions.emplace_back(std::move(extension)); }
+    inline void DeviceBuilder::setAsyncCompute(bool enabled) { m_asyncCompute = enabled; }
+    inline void DeviceBuilder::setPipelineCachePath(Path path) { m_pipelineCachePath = std::move(path); }
 
     inline const DeviceFeatures&               DeviceBuilder::getDeviceFeatures() const { return m_features; }
     inline DeviceFeatures&                     DeviceBuilder::getDeviceFeatures() { return m_features; }
     inline QueueType                           DeviceBuilder::getQueueTypes() const { return m_queueTypes; }
     inline const std::vector<dext::Extension>& DeviceBuilder::getExtensions() const { return m_extensions; }
+    inline bool                                DeviceBuilder::hasAsyncCompute() const { return m_asyncCompute; }
+
+    inline const Path& DeviceBuilder::getPipelineCachePath() const { return m_pipelineCachePath; }
+
+    inline bool MemoryHeapStatistics::isOverBudget() const { return usage > budget; }
 
     template <class Type>
     std::size_t PhysicalDevice::getUniformAlignment() const
@@ -26,6 +34,9 @@ namespace vzt
     inline const VolkDeviceTable&     Device::getFunctionTable() const { return m_table; }
     inline VmaAllocator               Device::getAllocator() const { return m_allocator; }
     inline PhysicalDevice             Device::getHardware() const { return m_device; }
+    inline bool                       Device::hasSynchronization2() const { return m_synchronization2; }
+    inline bool                       Device::hasTimelineSemaphore() const { return m_timelineSemaphore; }
+    inline PipelineCache&             Device::getPipelineCache() const { return *m_pipelineCache; }
     inline bool Device::isSameQueue(const Queue& q1, const Queue& q2) { return q1.getType() < q2.getType(); }
 
     template <class Handle>
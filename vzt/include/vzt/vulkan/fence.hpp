@@ -0,0 +1,32 @@
+#ifndef VZT_VULKAN_FENCE_HPP
+#define VZT_VULKAN_FENCE_HPP
+
+#include <limits>
+
+#include "vzt/core/type.hpp"
+#include "vzt/vulkan/device.hpp"
+
+namespace vzt
+{
+    class Fence : public DeviceObject<VkFence>
+    {
+      public:
+        Fence() = default;
+        Fence(View<Device> device, bool signaled = false);
+
+        Fence(const Fence&)            = delete;
+        Fence& operator=(const Fence&) = delete;
+
+        Fence(Fence&&) noexcept            = default;
+        Fence& operator=(Fence&&) noexcept = default;
+
+        ~Fence() override;
+
+        // Returns false if the fence is still not signaled after timeout nanoseconds
+        bool wait(uint64_t timeout = std::numeric_limits<uint64_t>::max()) const;
+        bool isSignaled() const;
+        void reset() const;
+    };
+} // namespace vzt
+
+#endif // VZT_VULKAN_FENCE_HPP
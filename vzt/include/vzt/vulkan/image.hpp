@@ -4,6 +4,7 @@
 #include "vzt/core/math.hpp"
 #include "vzt/core/type.hpp"
 #include "vzt/vulkan/device.hpp"
+#include "vzt/vulkan/memory.hpp"
 #include "vzt/vulkan/type.hpp"
 
 namespace vzt
@@ -33,6 +34,7 @@ namespace vzt
     class DeviceImage : public DeviceObject<VkImage>
     {
       public:
+        // Uploads data to the first level and generates the mip chain, all levels end in ShaderReadOnlyOptimal
         template <class ValueType>
         static DeviceImage From(View<Device> device, ImageUsage usage, Format format, uint32_t width, uint32_t height,
                                 const CSpan<ValueType> data, uint32_t mipLevels = 1,
@@ -53,6 +55,9 @@ namespace vzt
                     SharingMode sharingMode = SharingMode::Exclusive, ImageTiling tiling = ImageTiling::Optimal,
                     bool mappable = false);
         DeviceImage(View<Device> device, ImageBuilder builder);
+
+        // Places the image on an existing memory block, which is not owned by the image.
+        DeviceImage(View<Device> device, ImageBuilder builder, const DeviceMemory& memory, uint64_t offset = 0);
         DeviceImage(View<Device> device, VkImage image, Extent3D size, ImageUsage usage, Format format,
                     SharingMode sharingMode = SharingMode::Exclusive, ImageTiling tiling = ImageTiling::Optimal,
                     bool mappable = false);
@@ -65,6 +70,8 @@ namespace vzt
 
         ~DeviceImage() override;
 
+        // Mappable images are persistently mapped: map() returns the same pointer for their whole lifetime and unmap()
+        // only flushes host writes.
         template <class Type>
         Type* map();
         template <class Type>
@@ -73,9 +80,15 @@ namespace vzt
         const uint8_t* map() const;
         void           unmap() const;
 
+        // Required around host accesses when the memory is not host coherent, no-op otherwise
+        void flush(uint64_t offset = 0, uint64_t size = VK_WHOLE_SIZE) const;
+        void invalidate(uint64_t offset = 0, uint64_t size = VK_WHOLE_SIZE) const;
+
         SubresourceLayout getSubresourceLayout(const ImageAspect aspect, uint32_t mipLevel = 0,
                                                uint32_t arrayLayer = 0) const;
 
+        static MemoryRequirements getMemoryRequirements(View<Device> device, const ImageBuilder& builder);
+
         inline Extent3D      getSize() const;
         inline ImageUsage    getUsage() const;
         inline Format        getFormat() const;
@@ -83,10 +96,14 @@ namespace vzt
         inline SampleCount   getSampleCount() const;
         inline ImageType     getImageType() const;
         inline SharingMode   getSharingMode() const;
+        inline ImageTiling   getTiling() const;
         inline VmaAllocation getAllocation() const;
+        inline bool          isAliased() const;
 
       private:
         VmaAllocation m_allocation = VK_NULL_HANDLE;
+        uint8_t*      m_mapped     = nullptr;
+        bool          m_aliased    = false;
 
         Extent3D    m_size;
         ImageUsage  m_usage;
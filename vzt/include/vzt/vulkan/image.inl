@@ -30,7 +30,9 @@ namespace vzt
     inline SampleCount   DeviceImage::getSampleCount() const { return m_sampleCount; }
     inline ImageType     DeviceImage::getImageType() const { return m_type; }
     inline SharingMode   DeviceImage::getSharingMode() const { return m_sharingMode; }
+    inline ImageTiling   DeviceImage::getTiling() const { return m_tiling; }
     inline VmaAllocation DeviceImage::getAllocation() const { return m_allocation; }
+    inline bool          DeviceImage::isAliased() const { return m_aliased; }
 
     inline ImageAspect       ImageView::getAspect() const { return m_aspect; }
     inline Format            ImageView::getFormat() const { return m_format; }
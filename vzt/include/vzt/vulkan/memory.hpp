@@ -0,0 +1,41 @@
+#ifndef VZT_VULKAN_MEMORY_HPP
+#define VZT_VULKAN_MEMORY_HPP
+
+#include "vzt/core/type.hpp"
+#include "vzt/vulkan/device.hpp"
+
+namespace vzt
+{
+    struct MemoryRequirements
+    {
+        uint64_t size           = 0;
+        uint64_t alignment      = 1;
+        uint32_t memoryTypeBits = ~0u;
+    };
+
+    // Raw memory block on which resources can be placed at a given offset (See DeviceImage and Buffer aliasing
+    // constructors). Resources placed on a block must be destroyed before it.
+    class DeviceMemory : public DeviceObject<VmaAllocation>
+    {
+      public:
+        DeviceMemory() = default;
+        DeviceMemory(View<Device> device, MemoryRequirements requirements);
+
+        DeviceMemory(const DeviceMemory&)            = delete;
+        DeviceMemory& operator=(const DeviceMemory&) = delete;
+
+        DeviceMemory(DeviceMemory&& other) noexcept;
+        DeviceMemory& operator=(DeviceMemory&& other) noexcept;
+
+        ~DeviceMemory() override;
+
+        inline uint64_t size() const;
+
+      private:
+        uint64_t m_size = 0;
+    };
+} // namespace vzt
+
+#include "vzt/vulkan/memory.inl"
+
+#endif // VZT_VULKAN_MEMORY_HPP
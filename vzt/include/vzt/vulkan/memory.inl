@@ -0,0 +1,6 @@
+#include "vzt/vulkan/memory.hpp"
+
+namespace vzt
+{
+    inline uint64_t DeviceMemory::size() const { return m_size; }
+} // namespace vzt
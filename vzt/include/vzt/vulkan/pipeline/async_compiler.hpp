@@ -0,0 +1,48 @@
+#ifndef VZT_VULKAN_PIPELINE_ASYNC_COMPILER_HPP
+#define VZT_VULKAN_PIPELINE_ASYNC_COMPILER_HPP
+
+#include <chrono>
+#include <future>
+
+#include "vzt/core/thread_pool.hpp"
+#include "vzt/vulkan/pipeline/compute.hpp"
+#include "vzt/vulkan/pipeline/graphics.hpp"
+#include "vzt/vulkan/pipeline/raytracing.hpp"
+
+namespace vzt
+{
+    // Creates pipelines on worker threads, through the device pipeline cache which is internally synchronized.
+    // Programs and shader groups must outlive their compilation, pending compilations are completed before the
+    // compiler is destroyed.
+    class AsyncPipelineCompiler
+    {
+      public:
+        AsyncPipelineCompiler(uint32_t threadNb = std::thread::hardware_concurrency());
+
+        AsyncPipelineCompiler(const AsyncPipelineCompiler&)            = delete;
+        AsyncPipelineCompiler& operator=(const AsyncPipelineCompiler&) = delete;
+
+        AsyncPipelineCompiler(AsyncPipelineCompiler&&)            = delete;
+        AsyncPipelineCompiler& operator=(AsyncPipelineCompiler&&) = delete;
+
+        ~AsyncPipelineCompiler() = default;
+
+        std::future<GraphicsPipeline>   compile(GraphicsPipelineBuilder builder);
+        std::future<ComputePipeline>    compile(View<Program> program);
+        std::future<RaytracingPipeline> compile(View<ShaderGroup> shaderGroup);
+
+        // Returns true if future holds its pipeline, without blocking
+        template <class PipelineType>
+        static bool IsReady(const std::future<PipelineType>& future);
+
+      private:
+        template <class PipelineType, class Creator>
+        std::future<PipelineType> submit(Creator creator);
+
+        ThreadPool m_threads;
+    };
+} // namespace vzt
+
+#include "vzt/vulkan/pipeline/async_compiler.inl"
+
+#endif // VZT_VULKAN_PIPELINE_ASYNC_COMPILER_HPP
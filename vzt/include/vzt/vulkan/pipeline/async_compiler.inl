@@ -0,0 +1,31 @@
+#include "vzt/vulkan/pipeline/async_compiler.hpp"
+
+namespace vzt
+{
+    template <class PipelineType>
+    bool AsyncPipelineCompiler::IsReady(const std::future<PipelineType>& future)
+    {
+        return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    template <class PipelineType, class Creator>
+    std::future<PipelineType> AsyncPipelineCompiler::submit(Creator creator)
+    {
+        // Tasks must be copyable while promises are not
+        auto                      promise = std::make_shared<std::promise<PipelineType>>();
+        std::future<PipelineType> future  = promise->get_future();
+        m_threads.submit([promise, creator = std::move(creator)](uint32_t) {
+            // Failures are reported by the future rather than terminating the worker thread
+            try
+            {
+                promise->set_value(creator());
+            }
+            catch (...)
+            {
+                promise->set_exception(std::current_exception());
+            }
+        });
+
+        return future;
+    }
+} // namespace vzt
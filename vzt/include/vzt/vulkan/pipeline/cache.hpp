@@ -0,0 +1,46 @@
+#ifndef VZT_VULKAN_PIPELINE_CACHE_HPP
+#define VZT_VULKAN_PIPELINE_CACHE_HPP
+
+#include <mutex>
+#include <vector>
+
+#include "vzt/core/file.hpp"
+#include "vzt/core/type.hpp"
+#include "vzt/vulkan/device.hpp"
+
+namespace vzt
+{
+    class PipelineCache : public DeviceObject<VkPipelineCache>
+    {
+      public:
+        // Loads data previously saved at path, starting empty if the file is missing or was not created by the same
+        // driver and device
+        static PipelineCache From(View<Device> device, const Path& path);
+
+        // Checks the header of data against the vendor, device and pipeline cache UUID of the device
+        static bool IsCompatible(View<Device> device, CSpan<uint8_t> data);
+
+        PipelineCache() = default;
+        PipelineCache(View<Device> device, CSpan<uint8_t> initialData = {});
+
+        PipelineCache(const PipelineCache&)            = delete;
+        PipelineCache& operator=(const PipelineCache&) = delete;
+
+        PipelineCache(PipelineCache&& other) noexcept;
+        PipelineCache& operator=(PipelineCache&& other) noexcept;
+
+        ~PipelineCache() override;
+
+        // Pipelines can be created concurrently with the same cache, merges are serialized. Allows worker threads to
+        // build pipelines with their own cache and merge it once done.
+        void merge(const PipelineCache& other);
+
+        std::vector<uint8_t> getData() const;
+        bool                 save(const Path& path) const;
+
+      private:
+        mutable std::mutex m_mergeMutex;
+    };
+} // namespace vzt
+
+#endif // VZT_VULKAN_PIPELINE_CACHE_HPP
@@ -10,12 +10,23 @@
 
 namespace vzt
 {
+    // Value given at pipeline creation to the constant declared with [vk::constant_id(id)]
+    struct SpecializationConstant
+    {
+        uint32_t id;
+        uint32_t value; // 32 bit representation, booleans being stored as VkBool32
+
+        template <class Type>
+        static SpecializationConstant Typed(uint32_t id, Type value);
+    };
+
     struct Shader
     {
-        std::string                name;
-        ShaderStage                stage;
-        std::vector<uint32_t>      compiledSource;
-        DescriptorLayout::Bindings bindings;
+        std::string                         name;
+        ShaderStage                         stage;
+        std::vector<uint32_t>               compiledSource;
+        DescriptorLayout::Bindings          bindings;
+        std::vector<SpecializationConstant> specializationConstants = {};
 
         struct hash
         {
@@ -40,8 +51,15 @@ namespace vzt
         inline VkShaderModule getHandle() const;
         inline const Shader&  getShader() const;
 
+        // Null if the shader has no specialization constant
+        inline const VkSpecializationInfo* getSpecializationInfo() const;
+
       private:
         Shader m_shader = {};
+
+        // Refers to the constants of m_shader
+        std::vector<VkSpecializationMapEntry> m_specializationEntries = {};
+        VkSpecializationInfo                  m_specializationInfo    = {};
     };
 
     class Program
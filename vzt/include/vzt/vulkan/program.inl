@@ -1,7 +1,25 @@
+#include <cstring>
+#include <type_traits>
+
 #include "vzt/vulkan/program.hpp"
 
 namespace vzt
 {
+    template <class Type>
+    SpecializationConstant SpecializationConstant::Typed(uint32_t id, Type value)
+    {
+        static_assert(std::is_same_v<Type, bool> || sizeof(Type) == sizeof(uint32_t),
+                      "Specialization constants are 32 bit values.");
+
+        SpecializationConstant constant{id, 0};
+        if constexpr (std::is_same_v<Type, bool>)
+            constant.value = value ? VK_TRUE : VK_FALSE;
+        else
+            std::memcpy(&constant.value, &value, sizeof(uint32_t));
+
+        return constant;
+    }
+
     inline std::size_t Shader::hash::operator()(const Shader& handle) const
     {
         return static_cast<uint8_t>(handle.stage);
@@ -10,6 +28,11 @@ namespace vzt
     inline VkShaderModule ShaderModule::getHandle() const { return m_handle; }
     inline const Shader&  ShaderModule::getShader() const { return m_shader; }
 
+    inline const VkSpecializationInfo* ShaderModule::getSpecializationInfo() const
+    {
+        return m_specializationEntries.empty() ? nullptr : &m_specializationInfo;
+    }
+
     inline void Program::setShader(Shader shader)
     {
         m_shaderModules.emplace_back(ShaderModule(m_device, std::move(shader)));
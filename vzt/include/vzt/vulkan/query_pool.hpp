@@ -22,10 +22,11 @@ namespace vzt
 
         ~QueryPool() override;
 
+        // Returns false if some results are not available yet, which can only happen without QueryResultFlag::Wait
         template <typename ResultsType>
-        void getResults(uint32_t firstQuery, uint32_t queryCount, Span<ResultsType> results, std::size_t stride,
+        bool getResults(uint32_t firstQuery, uint32_t queryCount, Span<ResultsType> results, std::size_t stride,
                         QueryResultFlag flags) const;
-        void getResults(uint32_t firstQuery, uint32_t queryCount, Span<uint8_t> results, std::size_t stride,
+        bool getResults(uint32_t firstQuery, uint32_t queryCount, Span<uint8_t> results, std::size_t stride,
                         QueryResultFlag flags) const;
         inline VkQueryPool getHandle() const;
     };
@@ -0,0 +1,60 @@
+#ifndef VZT_VULKAN_SEMAPHORE_HPP
+#define VZT_VULKAN_SEMAPHORE_HPP
+
+#include <limits>
+
+#include "vzt/core/type.hpp"
+#include "vzt/vulkan/device.hpp"
+
+namespace vzt
+{
+    class Semaphore : public DeviceObject<VkSemaphore>
+    {
+      public:
+        Semaphore() = default;
+        Semaphore(View<Device> device, SemaphoreType type = SemaphoreType::Binary, uint64_t initialValue = 0);
+
+        Semaphore(const Semaphore&)            = delete;
+        Semaphore& operator=(const Semaphore&) = delete;
+
+        Semaphore(Semaphore&&) noexcept            = default;
+        Semaphore& operator=(Semaphore&&) noexcept = default;
+
+        ~Semaphore() override;
+
+        // Timeline semaphores only. wait() returns false if value is still not reached after timeout nanoseconds.
+        uint64_t getValue() const;
+        bool     wait(uint64_t value, uint64_t timeout = std::numeric_limits<uint64_t>::max()) const;
+        void     signal(uint64_t value) const;
+
+        inline SemaphoreType getType() const;
+
+      private:
+        SemaphoreType m_type = SemaphoreType::Binary;
+    };
+
+    // Blocks the given stages of a submission until the semaphore is signaled, or reaches value if it is a timeline
+    struct SemaphoreWait
+    {
+        View<Semaphore> semaphore;
+        PipelineStage   stage = PipelineStage::AllCommands;
+        uint64_t        value = 0;
+    };
+
+    // Completion of an asynchronous submission, reached once its timeline semaphore holds value
+    struct SubmissionFuture
+    {
+        View<Semaphore> semaphore;
+        uint64_t        value = 0;
+
+        bool isReady() const;
+        void wait() const;
+
+        // To be given to a later submission depending on this one
+        inline SemaphoreWait getWait(PipelineStage stage = PipelineStage::AllCommands) const;
+    };
+} // namespace vzt
+
+#include "vzt/vulkan/semaphore.inl"
+
+#endif // VZT_VULKAN_SEMAPHORE_HPP
@@ -0,0 +1,8 @@
+#include "vzt/vulkan/semaphore.hpp"
+
+namespace vzt
+{
+    inline SemaphoreType Semaphore::getType() const { return m_type; }
+
+    inline SemaphoreWait SubmissionFuture::getWait(PipelineStage stage) const { return {semaphore, stage, value}; }
+} // namespace vzt
@@ -782,6 +782,20 @@ namespace vzt
     };
     VZT_DEFINE_TO_VULKAN_FUNCTION(BorderColor, VkBorderColor)
 
+    enum class CommandBufferLevel
+    {
+        Primary   = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        Secondary = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+    };
+    VZT_DEFINE_TO_VULKAN_FUNCTION(CommandBufferLevel, VkCommandBufferLevel)
+
+    enum class SemaphoreType
+    {
+        Binary   = VK_SEMAPHORE_TYPE_BINARY,
+        Timeline = VK_SEMAPHORE_TYPE_TIMELINE,
+    };
+    VZT_DEFINE_TO_VULKAN_FUNCTION(SemaphoreType, VkSemaphoreType)
+
     enum class Rendering
     {
         None                            = 0,
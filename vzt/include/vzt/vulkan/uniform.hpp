@@ -4,6 +4,7 @@
 #include "vzt/vulkan/command.hpp"
 #include "vzt/vulkan/descriptor.hpp"
 #include "vzt/vulkan/device.hpp"
+#include "vzt/vulkan/upload.hpp"
 
 namespace vzt
 {
@@ -24,8 +25,10 @@ namespace vzt
         UniformBuffer(UniformBuffer&& buffer)            = default;
         UniformBuffer& operator=(UniformBuffer&& buffer) = default;
 
+        // Mappable uniform buffers are persistently mapped, flush() makes host writes of a frame visible
         uint8_t* map(uint32_t frameNb = 0) const;
         void     unMap() const;
+        void     flush(uint32_t frame = 0) const;
 
         template <class Type>
         void set(CSpan<Type> data, uint32_t frame = 0);
@@ -51,6 +54,59 @@ namespace vzt
         Buffer m_buffer;
         Buffer m_transferBuffer;
     };
+
+    struct DynamicUniformAllocation
+    {
+        uint8_t* data   = nullptr;
+        uint32_t offset = 0; // Dynamic offset to bind the allocation with
+    };
+
+    // Frame-scoped linear allocator of persistently mapped uniform memory, which is device local when the hardware
+    // exposes host visible VRAM. Allocations are slices aligned on minUniformBufferOffsetAlignment, read through a
+    // single UniformBufferDynamic descriptor of size range and bound with their offset. Writes only cost a memcpy,
+    // without any copy command or barrier.
+    class DynamicUniformBuffer
+    {
+      public:
+        DynamicUniformBuffer() = default;
+        DynamicUniformBuffer(View<Device> device, std::size_t perFrameByteNb, uint32_t frameNb, std::size_t range);
+
+        DynamicUniformBuffer(const DynamicUniformBuffer&)            = delete;
+        DynamicUniformBuffer& operator=(const DynamicUniformBuffer&) = delete;
+
+        DynamicUniformBuffer(DynamicUniformBuffer&&)            = default;
+        DynamicUniformBuffer& operator=(DynamicUniformBuffer&&) = default;
+
+        // Restarts allocations in the region of frame, whose previous submission must be complete
+        void reset(uint32_t frame);
+
+        DynamicUniformAllocation allocate(std::size_t byteNb);
+
+        // Copies data to a new allocation and returns its dynamic offset
+        template <class Type>
+        uint32_t push(CSpan<Type> data);
+        template <class Type>
+        uint32_t push(const Type& data);
+
+        // Makes the allocations of the current frame visible to the device, only needed on non-coherent memory
+        void flush() const;
+
+        inline std::size_t getRange() const;
+        inline std::size_t getUsedByteNb() const;
+
+        [[nodiscard]] DescriptorBuffer getDescriptor() const;
+
+      private:
+        std::size_t m_range        = 0;
+        std::size_t m_regionByteNb = 0;
+        std::size_t m_alignment    = 1;
+        uint32_t    m_frameNb      = 0;
+        uint32_t    m_frame        = 0;
+        std::size_t m_head         = 0; // Relative to the region of m_frame
+
+        Buffer   m_buffer;
+        uint8_t* m_data = nullptr;
+    };
 } // namespace vzt
 
 #include "vzt/vulkan/uniform.inl"
@@ -27,32 +27,15 @@ namespace vzt
     template <class Type>
     void UniformBuffer::set(CSpan<Type> data, uint32_t frame)
     {
-        uint8_t* ptr = m_transferBuffer.map();
-        std::memcpy(ptr + m_alignmentByteNb * frame, data.data, data.size * sizeof(Type));
-        m_transferBuffer.unMap();
-
-        // Transfer data
-        View<Device>      device = m_buffer.getDevice();
-        const View<Queue> queue  = device->getQueue(QueueType::Transfer);
-        queue->oneShot([&](CommandBuffer& commands) { //
-            commands.copy(m_transferBuffer, m_buffer, data.size * sizeof(Type), m_alignmentByteNb * frame,
-                          m_alignmentByteNb * frame);
-        });
+        // Only waits for the batch holding this copy instead of the whole transfer queue
+        UploadManager& uploader = m_buffer.getDevice()->getUploadManager();
+        uploader.wait(uploader.upload(data, m_buffer, m_alignmentByteNb * frame));
     }
 
     template <class Type>
     void UniformBuffer::set(const Type& data, uint32_t frame)
     {
-        uint8_t* ptr = m_transferBuffer.map();
-        std::memcpy(ptr + m_alignmentByteNb * frame, &data, sizeof(Type));
-        m_transferBuffer.unMap();
-
-        View<Device>      device = m_buffer.getDevice();
-        const View<Queue> queue  = device->getQueue(QueueType::Transfer);
-        queue->oneShot([&](CommandBuffer& commands) { //
-            commands.copy(m_transferBuffer, m_buffer, data.size * sizeof(Type), m_alignmentByteNb * frame,
-                          m_alignmentByteNb * frame);
-        });
+        set(CSpan<Type>(data), frame);
     }
 
     template <class Type>
@@ -60,7 +43,7 @@ namespace vzt
     {
         uint8_t* ptr = m_transferBuffer.map();
         std::memcpy(ptr + m_alignmentByteNb * frame, data.data, data.size * sizeof(Type));
-        m_transferBuffer.unMap();
+        m_transferBuffer.flush(m_alignmentByteNb * frame, data.size * sizeof(Type));
 
         commands.copy(m_transferBuffer, m_buffer, data.size * sizeof(Type), m_alignmentByteNb * frame,
                       frame * m_alignmentByteNb);
@@ -71,8 +54,25 @@ namespace vzt
     {
         uint8_t* ptr = m_transferBuffer.map();
         std::memcpy(ptr + m_alignmentByteNb * frame, &data, sizeof(Type));
-        m_transferBuffer.unMap();
+        m_transferBuffer.flush(m_alignmentByteNb * frame, sizeof(Type));
 
         commands.copy(m_transferBuffer, m_buffer, sizeof(Type), m_alignmentByteNb * frame, frame * m_alignmentByteNb);
     }
+
+    template <class Type>
+    uint32_t DynamicUniformBuffer::push(CSpan<Type> data)
+    {
+        const DynamicUniformAllocation allocation = allocate(data.size * sizeof(Type));
+        std::memcpy(allocation.data, data.data, data.size * sizeof(Type));
+        return allocation.offset;
+    }
+
+    template <class Type>
+    uint32_t DynamicUniformBuffer::push(const Type& data)
+    {
+        return push(CSpan<Type>(data));
+    }
+
+    inline std::size_t DynamicUniformBuffer::getRange() const { return m_range; }
+    inline std::size_t DynamicUniformBuffer::getUsedByteNb() const { return m_head; }
 } // namespace vzt
\ No newline at end of file
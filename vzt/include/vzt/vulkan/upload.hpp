@@ -0,0 +1,124 @@
+#ifndef VZT_VULKAN_UPLOAD_HPP
+#define VZT_VULKAN_UPLOAD_HPP
+
+#include <deque>
+#include <mutex>
+
+#include "vzt/core/type.hpp"
+#include "vzt/vulkan/buffer.hpp"
+#include "vzt/vulkan/command.hpp"
+#include "vzt/vulkan/semaphore.hpp"
+
+namespace vzt
+{
+    class DeviceImage;
+
+    // Uploads host data to device resources through a persistently mapped staging ring. Copies are recorded into
+    // batches submitted to the transfer queue without waiting for their completion, and ring regions are reclaimed once
+    // the timeline semaphore reaches the value of their batch. Uploads larger than the ring use a staging buffer
+    // released with the batch.
+    class UploadManager
+    {
+      public:
+        static constexpr uint64_t DefaultSize = 64ull * 1024ull * 1024ull;
+
+        UploadManager(View<Device> device, uint64_t size = DefaultSize, uint32_t batchNb = 8);
+
+        UploadManager(const UploadManager&)            = delete;
+        UploadManager& operator=(const UploadManager&) = delete;
+
+        UploadManager(UploadManager&&)            = delete;
+        UploadManager& operator=(UploadManager&&) = delete;
+
+        ~UploadManager();
+
+        // Stages data right away, the copy is executed with the current batch once it is submitted
+        template <class Type>
+        UploadToken upload(CSpan<Type> data, const Buffer& destination, uint64_t offset = 0);
+        UploadToken upload(CSpan<uint8_t> data, const Buffer& destination, uint64_t offset = 0);
+
+        // Copies data to the first level of the image and generates the other ones, all of them ending in
+        // ImageLayout::ShaderReadOnlyOptimal. Images with several levels need ImageUsage::TransferSrc, and are left in
+        // ImageLayout::TransferDstOptimal when the queue of the manager cannot generate mipmaps.
+        UploadToken upload(CSpan<uint8_t> data, const DeviceImage& destination, uint32_t width, uint32_t height);
+
+        // Submits the current batch without waiting and returns its token
+        UploadToken flush();
+
+        bool isComplete(UploadToken token);
+        void wait(UploadToken token);
+
+        // Submits the batch of token if needed, the future allows a submission on another queue to wait for it
+        SubmissionFuture getFuture(UploadToken token);
+
+        // Mipmaps are generated with blits, which require a queue supporting graphics operations
+        inline bool canGenerateMipmaps() const;
+
+      private:
+        struct Staging
+        {
+            const Buffer* buffer;
+            uint64_t      offset;
+        };
+
+        Staging       stage(CSpan<uint8_t> data);
+        CommandBuffer getCommands();
+        void          submit();
+        void          reclaim(bool waitOldest);
+
+        struct Batch
+        {
+            UploadToken         token = 0;
+            uint64_t            bytes = 0; // Ring bytes used by the batch, alignment padding included
+            std::vector<Buffer> dedicated; // Staging buffers of uploads larger than the ring
+        };
+
+        View<Device> m_device;
+        View<Queue>  m_queue;
+        Semaphore    m_timeline;
+        std::mutex   m_mutex;
+
+        Buffer   m_ring;
+        uint8_t* m_data      = nullptr;
+        uint64_t m_alignment = 16;
+        uint64_t m_head      = 0;
+        uint64_t m_used      = 0;
+
+        CommandPool           m_pool;
+        std::vector<Batch>    m_batches;  // [batchId], recorded into the command buffer batchId of m_pool
+        std::vector<uint32_t> m_free;     // Batches neither recording nor in flight
+        std::deque<uint32_t>  m_inFlight; // In submission order
+        Optional<uint32_t>    m_current;
+        UploadToken           m_next      = 1;
+        UploadToken           m_completed = 0;
+    };
+
+    // Creates resources whose uploads are recorded in the shared submissions of the upload manager, instead of
+    // waiting for each of them. Resources must be kept alive and unused until wait() returns.
+    class UploadBatch
+    {
+      public:
+        UploadBatch(View<Device> device);
+
+        template <class Type>
+        Buffer createBuffer(CSpan<Type> data, BufferUsage usages, MemoryLocation location = MemoryLocation::Device);
+        Buffer createBuffer(CSpan<uint8_t> data, BufferUsage usages, MemoryLocation location = MemoryLocation::Device);
+
+        // Images with several levels are uploaded and waited on the graphics queue when the upload manager cannot
+        // generate their mipmaps
+        DeviceImage createImage(CSpan<uint8_t> data, ImageUsage usage, Format format, uint32_t width, uint32_t height,
+                                uint32_t mipLevels = 1);
+
+        // Submits pending uploads without waiting and returns the token covering all of them
+        UploadToken submit();
+        void        wait();
+
+      private:
+        View<Device> m_device;
+        UploadToken  m_token = 0;
+    };
+} // namespace vzt
+
+#include "vzt/vulkan/upload.inl"
+
+#endif // VZT_VULKAN_UPLOAD_HPP
@@ -0,0 +1,20 @@
+#include "vzt/vulkan/upload.hpp"
+
+namespace vzt
+{
+    template <class Type>
+    UploadToken UploadManager::upload(CSpan<Type> data, const Buffer& destination, uint64_t offset)
+    {
+        const CSpan<uint8_t> translated = {reinterpret_cast<const uint8_t*>(data.data), data.size * sizeof(Type)};
+        return upload(translated, destination, offset);
+    }
+
+    inline bool UploadManager::canGenerateMipmaps() const { return any(m_queue->getType() & QueueType::Graphics); }
+
+    template <class Type>
+    Buffer UploadBatch::createBuffer(CSpan<Type> data, BufferUsage usages, MemoryLocation location)
+    {
+        const CSpan<uint8_t> translated = {reinterpret_cast<const uint8_t*>(data.data), data.size * sizeof(Type)};
+        return createBuffer(translated, usages, location);
+    }
+} // namespace vzt
@@ -1,5 +1,12 @@
 #include "vzt/compiler.hpp"
 
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 
 //
@@ -14,6 +21,7 @@
 
 #include "vzt/core/assert.hpp"
 #include "vzt/core/logger.hpp"
+#include "vzt/core/thread_pool.hpp"
 #include "vzt/vulkan/instance.hpp"
 
 namespace vzt
@@ -22,11 +30,21 @@ namespace vzt
     {
         Slang::ComPtr<slang::IGlobalSession> globalSession;
         Slang::ComPtr<slang::ISession>       session;
+
+        // Preprocessor macros are fixed at session creation, each set of defines has its own session
+        std::unordered_map<std::string, Slang::ComPtr<slang::ISession>> permutationSessions;
+
+        // Slang sessions are not thread-safe, guards session and permutationSessions
+        std::mutex sessionMutex;
+
+        std::mutex                                        shadersMutex;
+        std::unordered_map<uint64_t, std::vector<Shader>> shaders;
     };
 
     struct Module::Implementation
     {
         slang::IModule* data;
+        Path            path;
     };
 
     ShaderStage toShaderStage(SlangStage stage)
@@ -126,51 +144,255 @@ namespace vzt
         return DescriptorType::None;
     }
 
-    Compiler::Compiler()                            = default;
-    Compiler::Compiler(Compiler&& other)            = default;
-    Compiler& Compiler::operator=(Compiler&& other) = default;
-    Compiler::~Compiler()                           = default;
+    // Cache entries store the dependency files of the shaders with the hash of their content, followed by the shaders
+    constexpr uint32_t ShaderCacheMagic   = 0x5a54'5653;
+    constexpr uint32_t ShaderCacheVersion = 1;
+
+    // Target and options of the sessions, both being part of the cache key
+    constexpr const char* ShaderTargetProfile = "spirv_1_5";
 
-    Compiler::Compiler(View<Instance> instance, const std::vector<vzt::Path>& includeDirectories) : m_instance(instance)
+    struct ShaderCompilerOption
     {
-        m_implementation = std::make_unique<Implementation>();
+        slang::CompilerOptionName name;
+        int32_t                   value;
+    };
 
-        slang::createGlobalSession(m_implementation->globalSession.writeRef());
+    constexpr std::array<ShaderCompilerOption, 3> ShaderCompilerOptions = {{
+        {slang::CompilerOptionName::EmitSpirvDirectly, 1},
+        {slang::CompilerOptionName::Optimization, SLANG_OPTIMIZATION_LEVEL_DEFAULT},
+#ifndef NDEBUG
+        {slang::CompilerOptionName::DebugInformation, SLANG_DEBUG_INFO_LEVEL_MAXIMAL},
+#else
+        {slang::CompilerOptionName::DebugInformation, SLANG_DEBUG_INFO_LEVEL_NONE},
+#endif // NDEBUG
+    }};
+
+    // FNV-1a
+    static uint64_t hashData(std::string_view data, uint64_t hash = 0xcbf29ce484222325ull)
+    {
+        for (const char c : data)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 0x100000001b3ull;
+        }
+
+        return hash;
+    }
+
+    static Optional<uint64_t> hashFile(const Path& path)
+    {
+        std::ifstream file{path, std::ios::binary};
+        if (!file.is_open())
+            return {};
+
+        const std::string content{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        return hashData(content);
+    }
+
+    template <class Type>
+    static void writeValue(std::ostream& stream, const Type& value)
+    {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(Type));
+    }
+
+    static void writeString(std::ostream& stream, std::string_view str)
+    {
+        writeValue(stream, static_cast<uint32_t>(str.size()));
+        stream.write(str.data(), static_cast<std::streamsize>(str.size()));
+    }
+
+    template <class Type>
+    static bool readValue(std::istream& stream, Type& value)
+    {
+        return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(Type)));
+    }
+
+    // Counts read from a cache entry are bounded by its remaining bytes so that corrupted entries are never allocated
+    static bool fits(std::istream& stream, uint64_t fileSize, uint64_t count, uint64_t elementSize)
+    {
+        const std::streamoff position = stream.tellg();
+        if (position < 0 || static_cast<uint64_t>(position) > fileSize)
+            return false;
+
+        return count <= (fileSize - static_cast<uint64_t>(position)) / elementSize;
+    }
+
+    static bool readString(std::istream& stream, uint64_t fileSize, std::string& str)
+    {
+        uint32_t size = 0;
+        if (!readValue(stream, size) || !fits(stream, fileSize, size, sizeof(char)))
+            return false;
+
+        str.resize(size);
+        return static_cast<bool>(stream.read(str.data(), static_cast<std::streamsize>(size)));
+    }
+
+    static Optional<std::vector<Shader>> readShaderCache(const Path& file)
+    {
+        std::error_code error;
+        const uint64_t  fileSize = std::filesystem::file_size(file, error);
+        if (error)
+            return {};
+
+        std::ifstream stream{file, std::ios::binary};
+        if (!stream.is_open())
+            return {};
+
+        uint32_t magic   = 0;
+        uint32_t version = 0;
+        if (!readValue(stream, magic) || !readValue(stream, version) || magic != ShaderCacheMagic ||
+            version != ShaderCacheVersion)
+            return {};
+
+        // The entry is stale as soon as one of its dependencies changed or disappeared
+        uint32_t dependencyNb = 0;
+        if (!readValue(stream, dependencyNb))
+            return {};
+
+        for (uint32_t d = 0; d < dependencyNb; d++)
+        {
+            std::string path;
+            uint64_t    hash = 0;
+            if (!readString(stream, fileSize, path) || !readValue(stream, hash))
+                return {};
+
+            const Optional<uint64_t> current = hashFile(path);
+            if (!current || *current != hash)
+                return {};
+        }
+
+        // Each shader stores at least its name size, stage, word count and binding count
+        uint32_t shaderNb = 0;
+        if (!readValue(stream, shaderNb) || !fits(stream, fileSize, shaderNb, 4 * sizeof(uint32_t)))
+            return {};
+
+        std::vector<Shader> shaders(shaderNb);
+        for (Shader& shader : shaders)
+        {
+            uint32_t stage  = 0;
+            uint32_t wordNb = 0;
+            if (!readString(stream, fileSize, shader.name) || !readValue(stream, stage) || !readValue(stream, wordNb) ||
+                !fits(stream, fileSize, wordNb, sizeof(uint32_t)))
+                return {};
+
+            shader.stage = static_cast<ShaderStage>(stage);
+            shader.compiledSource.resize(wordNb);
+
+            const auto byteNb = static_cast<std::streamsize>(wordNb * sizeof(uint32_t));
+            if (!stream.read(reinterpret_cast<char*>(shader.compiledSource.data()), byteNb))
+                return {};
+
+            uint32_t bindingNb = 0;
+            if (!readValue(stream, bindingNb) || !fits(stream, fileSize, bindingNb, 2 * sizeof(uint32_t)))
+                return {};
+
+            for (uint32_t b = 0; b < bindingNb; b++)
+            {
+                uint32_t binding = 0;
+                uint32_t type    = 0;
+                if (!readValue(stream, binding) || !readValue(stream, type))
+                    return {};
+
+                shader.bindings[binding] = static_cast<DescriptorType>(type);
+            }
+        }
+
+        return shaders;
+    }
+
+    static void writeShaderCache(const Path& file, const std::vector<std::string>& dependencies, CSpan<Shader> shaders)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(file.parent_path(), error);
+
+        // Written aside and renamed so that other readers never see a partial entry
+        const std::size_t threadId  = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        Path              temporary = file;
+        temporary += fmt::format(".{:x}.tmp", threadId);
+        {
+            std::ofstream stream{temporary, std::ios::binary | std::ios::trunc};
+            if (!stream.is_open())
+            {
+                logger::warn("[Compiler] Failed to write shader cache entry {}.", file.string());
+                return;
+            }
+
+            writeValue(stream, ShaderCacheMagic);
+            writeValue(stream, ShaderCacheVersion);
 
+            writeValue(stream, static_cast<uint32_t>(dependencies.size()));
+            for (const std::string& dependency : dependencies)
+            {
+                writeString(stream, dependency);
+                writeValue(stream, hashFile(dependency).value_or(0));
+            }
+
+            writeValue(stream, static_cast<uint32_t>(shaders.size));
+            for (const Shader& shader : shaders)
+            {
+                writeString(stream, shader.name);
+                writeValue(stream, static_cast<uint32_t>(shader.stage));
+
+                writeValue(stream, static_cast<uint32_t>(shader.compiledSource.size()));
+                stream.write(reinterpret_cast<const char*>(shader.compiledSource.data()),
+                             static_cast<std::streamsize>(shader.compiledSource.size() * sizeof(uint32_t)));
+
+                writeValue(stream, static_cast<uint32_t>(shader.bindings.size()));
+                for (const auto [binding, type] : shader.bindings)
+                {
+                    writeValue(stream, binding);
+                    writeValue(stream, static_cast<uint32_t>(type));
+                }
+            }
+        }
+
+        std::filesystem::rename(temporary, file, error);
+        if (error)
+            std::filesystem::remove(temporary, error);
+    }
+
+    // Files read by Slang to build the modules, their own source and transitive imports and includes
+    static std::vector<std::string> getDependencyFiles(CSpan<slang::IModule*> modules)
+    {
+        std::vector<std::string> dependencies;
+        for (slang::IModule* module : modules)
+        {
+            const int32_t dependencyNb = module->getDependencyFileCount();
+            for (int32_t d = 0; d < dependencyNb; d++)
+                dependencies.emplace_back(module->getDependencyFilePath(d));
+        }
+
+        return dependencies;
+    }
+
+    static Slang::ComPtr<slang::ISession> createSession(slang::IGlobalSession*   globalSession,
+                                                        const std::vector<Path>& includePaths,
+                                                        CSpan<ShaderDefine>      defines = {})
+    {
         slang::SessionDesc sessionDesc = {};
         slang::TargetDesc  target      = {
                   .format  = SLANG_SPIRV,
-                  .profile = m_implementation->globalSession->findProfile("spirv_1_5"),
+                  .profile = globalSession->findProfile(ShaderTargetProfile),
                   .flags   = 0,
         };
 
         sessionDesc.targets     = &target;
         sessionDesc.targetCount = 1;
 
-        std::vector<slang::CompilerOptionEntry> compilerOptions = {
-            {slang::CompilerOptionName::EmitSpirvDirectly, //
-             {slang::CompilerOptionValueKind::Int, 1, 0, nullptr, nullptr}},
-            {slang::CompilerOptionName::Optimization,
-             {slang::CompilerOptionValueKind::Int, SLANG_OPTIMIZATION_LEVEL_DEFAULT, 0, nullptr, nullptr}},
-            {slang::CompilerOptionName::DebugInformation,
-             {
-                 slang::CompilerOptionValueKind::Int,
-#ifndef NDEBUG
-                 SLANG_DEBUG_INFO_LEVEL_MAXIMAL,
-#else
-                 SLANG_DEBUG_INFO_LEVEL_NONE,
-#endif // NDEBUG
-                 0,
-                 nullptr,
-                 nullptr,
-             }},
-        };
+        std::vector<slang::CompilerOptionEntry> compilerOptions;
+        compilerOptions.reserve(ShaderCompilerOptions.size());
+        for (const ShaderCompilerOption& option : ShaderCompilerOptions)
+        {
+            const slang::CompilerOptionValue value{slang::CompilerOptionValueKind::Int, option.value, 0, nullptr,
+                                                   nullptr};
+            compilerOptions.emplace_back(slang::CompilerOptionEntry{option.name, value});
+        }
         sessionDesc.compilerOptionEntries    = compilerOptions.data();
         sessionDesc.compilerOptionEntryCount = static_cast<uint32_t>(compilerOptions.size());
 
         std::vector<std::string> searchPathsStrs;
         std::vector<const char*> searchPaths;
-        std::transform(begin(includeDirectories), end(includeDirectories), std::back_inserter(searchPathsStrs),
+        std::transform(begin(includePaths), end(includePaths), std::back_inserter(searchPathsStrs),
                        [](const vzt::Path& path) { return path.string(); });
         std::transform(begin(searchPathsStrs), end(searchPathsStrs), std::back_inserter(searchPaths),
                        [](const std::string& path) { return path.c_str(); });
@@ -178,47 +400,48 @@ namespace vzt
         sessionDesc.searchPaths     = searchPaths.data();
         sessionDesc.searchPathCount = static_cast<SlangInt>(searchPaths.size());
 
-        m_implementation->globalSession->createSession(sessionDesc, m_implementation->session.writeRef());
+        std::vector<slang::PreprocessorMacroDesc> macros;
+        macros.reserve(defines.size);
+        for (const ShaderDefine& define : defines)
+            macros.emplace_back(slang::PreprocessorMacroDesc{define.name.c_str(), define.value.c_str()});
+
+        sessionDesc.preprocessorMacros     = macros.data();
+        sessionDesc.preprocessorMacroCount = static_cast<SlangInt>(macros.size());
+
+        Slang::ComPtr<slang::ISession> session;
+        globalSession->createSession(sessionDesc, session.writeRef());
+
+        return session;
     }
 
-    Shader Compiler::operator()(const Path& path, const std::string& entryPoint, CSpan<Module> modules) const
+    static slang::IModule* loadModule(slang::ISession* session, const Path& path)
     {
         const std::string pathStr = path.string();
 
         Slang::ComPtr<slang::IBlob> diagnostics;
-        slang::IModule*             module;
+        slang::IModule*             module = session->loadModule(pathStr.c_str(), diagnostics.writeRef());
+        if (!module)
         {
-            module = m_implementation->session->loadModule(pathStr.c_str(), diagnostics.writeRef());
-            if (!module)
-            {
-                vzt::logger::error("[SLANG] Compile Error, diagnostic {}",
-                                   reinterpret_cast<const char*>(diagnostics->getBufferPointer()));
-                std::abort();
-            }
+            vzt::logger::error("[SLANG] Compile Error, diagnostic {}",
+                               reinterpret_cast<const char*>(diagnostics->getBufferPointer()));
+            std::abort();
         }
 
-        const int32_t entryPointCount = module->getDefinedEntryPointCount();
-
-        bool foundEntryPoint = false;
-        for (int32_t i = 0; i < entryPointCount; ++i)
-        {
-            Slang::ComPtr<slang::IEntryPoint> iEntryPoint;
-            module->getDefinedEntryPoint(i, iEntryPoint.writeRef());
-
-            foundEntryPoint |= iEntryPoint->getFunctionReflection()->getName() == entryPoint;
-        }
-        VZT_ASSERT(foundEntryPoint);
+        return module;
+    }
 
-        Slang::ComPtr<slang::IEntryPoint> iEntryPoint;
-        module->findEntryPointByName(entryPoint.c_str(), iEntryPoint.writeRef());
+    static Shader compileEntryPoint(slang::ISession* session, slang::IModule* module, slang::IEntryPoint* iEntryPoint,
+                                    CSpan<slang::IModule*> modules)
+    {
+        Slang::ComPtr<slang::IBlob> diagnostics;
 
         Slang::ComPtr<slang::IComponentType> composedProgram;
         {
             std::vector<slang::IComponentType*> componentTypes = {module, iEntryPoint};
-            for (uint32_t m = 0; m < modules.size; ++m)
-                componentTypes.emplace_back(modules[m].implementation->data);
+            for (slang::IModule* linked : modules)
+                componentTypes.emplace_back(linked);
 
-            if (SLANG_FAILED(m_implementation->session->createCompositeComponentType( //
+            if (SLANG_FAILED(session->createCompositeComponentType( //
                     componentTypes.data(), static_cast<SlangInt>(componentTypes.size()), composedProgram.writeRef(),
                     diagnostics.writeRef())))
             {
@@ -229,16 +452,15 @@ namespace vzt
         }
 
         Slang::ComPtr<slang::IBlob> kernelBlob;
+        if (SLANG_FAILED(composedProgram->getEntryPointCode(0, 0, kernelBlob.writeRef(), diagnostics.writeRef())))
         {
-            Slang::ComPtr<slang::IBlob> diagnosticsBlob;
-            if (SLANG_FAILED(composedProgram->getEntryPointCode(0, 0, kernelBlob.writeRef(), diagnostics.writeRef())))
-            {
-                vzt::logger::error("[SLANG] Compile Error, diagnostic {}",
-                                   reinterpret_cast<const char*>(diagnostics->getBufferPointer()));
-                std::abort();
-            }
+            vzt::logger::error("[SLANG] Compile Error, diagnostic {}",
+                               reinterpret_cast<const char*>(diagnostics->getBufferPointer()));
+            std::abort();
         }
 
+        const std::string entryPoint = iEntryPoint->getFunctionReflection()->getName();
+
         slang::ProgramLayout*        programLayout = composedProgram->getLayout();
         slang::EntryPointReflection* reflection    = programLayout->findEntryPointByName(entryPoint.c_str());
 
@@ -251,9 +473,8 @@ namespace vzt
         {
             slang::VariableLayoutReflection* variableLayout = programLayout->getParameterByIndex(p);
 
-            const uint32_t bindingId = variableLayout->getBindingIndex();
-
-            const DescriptorType type = toDescriptorType(variableLayout);
+            const uint32_t       bindingId = variableLayout->getBindingIndex();
+            const DescriptorType type      = toDescriptorType(variableLayout);
             if (type == DescriptorType::None)
                 continue;
 
@@ -263,87 +484,291 @@ namespace vzt
         return shader;
     }
 
-    std::vector<Shader> Compiler::operator()(const Path& path, CSpan<Module> modules) const
+    // Compiles entryPoint, or all entry points of the file if empty, and stores the result at cachePath if not empty
+    static std::vector<Shader> compile(slang::ISession* session, const Path& path, const std::string& entryPoint,
+                                       CSpan<slang::IModule*> modules, const Path& cachePath)
     {
-        const std::string pathStr = path.string();
+        slang::IModule* module = loadModule(session, path);
 
-        Slang::ComPtr<slang::IBlob> diagnostics;
-        slang::IModule*             module;
+        const int32_t       entryPointCount = module->getDefinedEntryPointCount();
+        std::vector<Shader> shaders         = {};
+        if (entryPoint.empty())
         {
-            module = m_implementation->session->loadModule(pathStr.c_str(), diagnostics.writeRef());
-            if (!module)
+            shaders.reserve(static_cast<std::size_t>(entryPointCount));
+            for (int32_t i = 0; i < entryPointCount; ++i)
             {
-                vzt::logger::error("[SLANG] Compile Error, diagnostic {}",
-                                   reinterpret_cast<const char*>(diagnostics->getBufferPointer()));
-                std::abort();
+                Slang::ComPtr<slang::IEntryPoint> iEntryPoint;
+                module->getDefinedEntryPoint(i, iEntryPoint.writeRef());
+
+                shaders.emplace_back(compileEntryPoint(session, module, iEntryPoint, modules));
             }
         }
+        else
+        {
+            bool foundEntryPoint = false;
+            for (int32_t i = 0; i < entryPointCount; ++i)
+            {
+                Slang::ComPtr<slang::IEntryPoint> iEntryPoint;
+                module->getDefinedEntryPoint(i, iEntryPoint.writeRef());
 
-        const int32_t       entryPointCount = module->getDefinedEntryPointCount();
-        std::vector<Shader> shaders         = {};
-        shaders.reserve(static_cast<std::size_t>(entryPointCount));
+                foundEntryPoint |= iEntryPoint->getFunctionReflection()->getName() == entryPoint;
+            }
+            VZT_ASSERT(foundEntryPoint);
 
-        for (int32_t i = 0; i < entryPointCount; ++i)
-        {
             Slang::ComPtr<slang::IEntryPoint> iEntryPoint;
-            module->getDefinedEntryPoint(i, iEntryPoint.writeRef());
+            module->findEntryPointByName(entryPoint.c_str(), iEntryPoint.writeRef());
 
-            Slang::ComPtr<slang::IComponentType> composedProgram;
-            {
-                std::vector<slang::IComponentType*> componentTypes = {module, iEntryPoint};
-                for (uint32_t m = 0; m < modules.size; ++m)
-                    componentTypes.emplace_back(modules[m].implementation->data);
+            shaders.emplace_back(compileEntryPoint(session, module, iEntryPoint, modules));
+        }
 
-                if (SLANG_FAILED(m_implementation->session->createCompositeComponentType( //
-                        componentTypes.data(), static_cast<SlangInt>(componentTypes.size()), composedProgram.writeRef(),
-                        diagnostics.writeRef())))
-                {
-                    vzt::logger::error("[SLANG] Compile Error, diagnostic {}",
-                                       reinterpret_cast<const char*>(diagnostics->getBufferPointer()));
-                    std::abort();
-                }
-            }
+        if (!cachePath.empty())
+        {
+            std::vector<slang::IModule*> dependencies = {module};
+            dependencies.insert(dependencies.end(), modules.begin(), modules.end());
+
+            writeShaderCache(cachePath, getDependencyFiles(dependencies), shaders);
+        }
+
+        return shaders;
+    }
+
+    // Sorted so that the order in which defines are given does not matter
+    static std::string getDefinesKey(CSpan<ShaderDefine> defines)
+    {
+        std::vector<std::string> entries;
+        entries.reserve(defines.size);
+        for (const ShaderDefine& define : defines)
+            entries.emplace_back(fmt::format("{}={}", define.name, define.value));
+        std::sort(entries.begin(), entries.end());
+
+        std::string key;
+        for (const std::string& entry : entries)
+            key += entry + ";";
 
-            Slang::ComPtr<slang::IBlob> kernelBlob;
+        return key;
+    }
+
+    static std::vector<Shader> specialize(std::vector<Shader> shaders, CSpan<SpecializationConstant> constants)
+    {
+        for (Shader& shader : shaders)
+            shader.specializationConstants.assign(constants.begin(), constants.end());
+
+        return shaders;
+    }
+
+    std::string ShaderPermutation::getKey() const
+    {
+        std::vector<SpecializationConstant> sortedConstants = constants;
+        std::sort(sortedConstants.begin(), sortedConstants.end(),
+                  [](const SpecializationConstant& a, const SpecializationConstant& b) { return a.id < b.id; });
+
+        std::string key = getDefinesKey(defines);
+        for (const SpecializationConstant& constant : sortedConstants)
+            key += fmt::format("#{}={:x}", constant.id, constant.value);
+
+        return key;
+    }
+
+    Compiler::Compiler()                            = default;
+    Compiler::Compiler(Compiler&& other)            = default;
+    Compiler& Compiler::operator=(Compiler&& other) = default;
+    Compiler::~Compiler()                           = default;
+
+    Compiler::Compiler(View<Instance> instance, const std::vector<vzt::Path>& includeDirectories)
+        : m_instance(instance), m_includePaths(includeDirectories)
+    {
+        m_implementation = std::make_unique<Implementation>();
+
+        slang::createGlobalSession(m_implementation->globalSession.writeRef());
+        m_implementation->session = createSession(m_implementation->globalSession, m_includePaths);
+    }
+
+    Shader Compiler::operator()(const Path& path, const std::string& entryPoint, CSpan<Module> modules) const
+    {
+        std::vector<Shader> shaders = compile({path, entryPoint, modules});
+        return std::move(shaders.front());
+    }
+
+    std::vector<Shader> Compiler::operator()(const Path& path, CSpan<Module> modules) const
+    {
+        return compile({path, {}, modules});
+    }
+
+    Shader Compiler::operator()(const Path& path, const std::string& entryPoint, const ShaderPermutation& permutation,
+                                CSpan<Module> modules) const
+    {
+        std::vector<Shader> shaders = compile({path, entryPoint, modules, permutation});
+        return std::move(shaders.front());
+    }
+
+    std::vector<Shader> Compiler::operator()(const Path& path, const ShaderPermutation& permutation,
+                                             CSpan<Module> modules) const
+    {
+        return compile({path, {}, modules, permutation});
+    }
+
+    std::vector<std::vector<Shader>> Compiler::operator()(CSpan<ShaderCompilation> compilations,
+                                                          ThreadPool&              pool) const
+    {
+        // Identical compilations, which may only differ by their specialization constants, are only compiled once
+        std::vector<uint64_t>                  keys(compilations.size);
+        std::vector<uint32_t>                  uniqueCompilations;
+        std::unordered_map<uint64_t, uint32_t> uniqueIds;
+        for (uint32_t i = 0; i < compilations.size; i++)
+        {
+            keys[i] = getKey(compilations[i]);
+            if (uniqueIds.emplace(keys[i], static_cast<uint32_t>(uniqueCompilations.size())).second)
+                uniqueCompilations.emplace_back(i);
+        }
+
+        // Slang global sessions and the sessions created from them are not thread-safe, each worker thread lazily
+        // creates its own global session and sessions
+        struct WorkerSessions
+        {
+            Slang::ComPtr<slang::IGlobalSession>                            globalSession;
+            std::unordered_map<std::string, Slang::ComPtr<slang::ISession>> sessions;
+        };
+        std::vector<WorkerSessions> workers(pool.size());
+
+        std::vector<std::vector<Shader>> uniqueResults(uniqueCompilations.size());
+        pool.parallelFor(static_cast<uint32_t>(uniqueCompilations.size()), [&](uint32_t i, uint32_t threadId) {
+            const ShaderCompilation& compilation = compilations[uniqueCompilations[i]];
+            const uint64_t           key         = keys[uniqueCompilations[i]];
+            if (Optional<std::vector<Shader>> shaders = find(key))
             {
-                Slang::ComPtr<slang::IBlob> diagnosticsBlob;
-                if (SLANG_FAILED(
-                        composedProgram->getEntryPointCode(0, 0, kernelBlob.writeRef(), diagnostics.writeRef())))
-                {
-                    vzt::logger::error("[SLANG] Compile Error, diagnostic {}",
-                                       reinterpret_cast<const char*>(diagnostics->getBufferPointer()));
-                    std::abort();
-                }
+                uniqueResults[i] = std::move(*shaders);
+                return;
             }
 
-            const std::string entryPoint = iEntryPoint->getFunctionReflection()->getName();
+            WorkerSessions& worker = workers[threadId];
+            if (!worker.globalSession)
+                slang::createGlobalSession(worker.globalSession.writeRef());
 
-            slang::ProgramLayout*        programLayout = composedProgram->getLayout();
-            slang::EntryPointReflection* reflection    = programLayout->findEntryPointByName(entryPoint.c_str());
+            const CSpan<ShaderDefine>       defines = compilation.permutation.defines;
+            Slang::ComPtr<slang::ISession>& session = worker.sessions[getDefinesKey(defines)];
+            if (!session)
+                session = createSession(worker.globalSession, m_includePaths, defines);
 
-            Shader shader = Shader(entryPoint, toShaderStage(reflection->getStage()), {});
-            shader.compiledSource.resize(kernelBlob->getBufferSize() / sizeof(uint32_t));
-            std::memcpy(shader.compiledSource.data(), kernelBlob->getBufferPointer(), kernelBlob->getBufferSize());
+            // Modules belong to the session which loaded them and are loaded again in the worker's session
+            std::vector<slang::IModule*> linked;
+            for (uint32_t m = 0; m < compilation.modules.size; ++m)
+                linked.emplace_back(loadModule(session, compilation.modules[m].implementation->path));
 
-            const uint32_t parameterCount = programLayout->getParameterCount();
-            for (uint32_t p = 0; p < parameterCount; p++)
-            {
-                slang::VariableLayoutReflection* variableLayout = programLayout->getParameterByIndex(p);
+            uniqueResults[i] =
+                vzt::compile(session, compilation.path, compilation.entryPoint, linked, getCachePath(key));
+            store(key, uniqueResults[i]);
+        });
 
-                const uint32_t       bindingId = variableLayout->getBindingIndex();
-                const DescriptorType type      = toDescriptorType(variableLayout);
-                if (type == DescriptorType::None)
-                    continue;
+        std::vector<std::vector<Shader>> results(compilations.size);
+        for (uint32_t i = 0; i < compilations.size; i++)
+            results[i] = specialize(uniqueResults[uniqueIds[keys[i]]], compilations[i].permutation.constants);
 
-                shader.bindings[bindingId] = type;
-            }
+        return results;
+    }
+
+    void Compiler::setCacheDirectory(Path directory) { m_cacheDirectory = std::move(directory); }
+
+    void Compiler::clear()
+    {
+        std::lock_guard lock{m_implementation->shadersMutex};
+        m_implementation->shaders.clear();
+    }
+
+    uint64_t Compiler::getKey(const ShaderCompilation& compilation) const
+    {
+        // Separators keep consecutive fields from being ambiguous
+        uint64_t   key     = 0xcbf29ce484222325ull;
+        const auto combine = [&key](std::string_view data) { key = hashData(data, hashData({"\0", 1}, key)); };
+
+        combine(m_implementation->globalSession->getBuildTagString());
+        combine(ShaderTargetProfile);
+        for (const ShaderCompilerOption& option : ShaderCompilerOptions)
+            combine(fmt::format("{}={}", static_cast<int32_t>(option.name), option.value));
+        for (const Path& includePath : m_includePaths)
+            combine(includePath.string());
+
+        // All entry points are stored under an empty entry point name
+        combine(compilation.path.string());
+        combine(compilation.entryPoint);
+        for (uint32_t m = 0; m < compilation.modules.size; ++m)
+            combine(compilation.modules[m].implementation->path.string());
+
+        // Specialization constants are applied at pipeline creation and do not change the compiled code
+        combine(getDefinesKey(compilation.permutation.defines));
+
+        return key;
+    }
+
+    Path Compiler::getCachePath(uint64_t key) const
+    {
+        if (m_cacheDirectory.empty())
+            return {};
 
-            shaders.emplace_back(std::move(shader));
+        return m_cacheDirectory / fmt::format("{:016x}.spv", key);
+    }
+
+    Optional<std::vector<Shader>> Compiler::find(uint64_t key) const
+    {
+        {
+            std::lock_guard lock{m_implementation->shadersMutex};
+            if (auto it = m_implementation->shaders.find(key); it != m_implementation->shaders.end())
+                return it->second;
         }
 
+        const Path cachePath = getCachePath(key);
+        if (cachePath.empty())
+            return {};
+
+        Optional<std::vector<Shader>> shaders = readShaderCache(cachePath);
+        if (shaders)
+            store(key, *shaders);
+
         return shaders;
     }
 
+    void Compiler::store(uint64_t key, const std::vector<Shader>& shaders) const
+    {
+        std::lock_guard lock{m_implementation->shadersMutex};
+        m_implementation->shaders[key] = shaders;
+    }
+
+    std::vector<Shader> Compiler::compile(const ShaderCompilation& compilation) const
+    {
+        const uint64_t                             key       = getKey(compilation);
+        const std::vector<SpecializationConstant>& constants = compilation.permutation.constants;
+        if (Optional<std::vector<Shader>> shaders = find(key))
+            return specialize(std::move(*shaders), constants);
+
+        const std::vector<ShaderDefine>& defines = compilation.permutation.defines;
+
+        std::lock_guard              lock{m_implementation->sessionMutex};
+        slang::ISession*             session = m_implementation->session;
+        std::vector<slang::IModule*> linked;
+        if (defines.empty())
+        {
+            for (uint32_t m = 0; m < compilation.modules.size; ++m)
+                linked.emplace_back(compilation.modules[m].implementation->data);
+        }
+        else
+        {
+            Slang::ComPtr<slang::ISession>& permutationSession =
+                m_implementation->permutationSessions[getDefinesKey(defines)];
+            if (!permutationSession)
+                permutationSession = createSession(m_implementation->globalSession, m_includePaths, defines);
+
+            // Modules are loaded again so that the defines also apply to them
+            session = permutationSession;
+            for (uint32_t m = 0; m < compilation.modules.size; ++m)
+                linked.emplace_back(loadModule(session, compilation.modules[m].implementation->path));
+        }
+
+        std::vector<Shader> shaders =
+            vzt::compile(session, compilation.path, compilation.entryPoint, linked, getCachePath(key));
+        store(key, shaders);
+
+        return specialize(std::move(shaders), constants);
+    }
+
     Module::Module()                                   = default;
     Module::Module(Module&& other) noexcept            = default;
     Module& Module::operator=(Module&& other) noexcept = default;
@@ -352,22 +777,14 @@ namespace vzt
 
     Module Compiler::load(const Path& path) const
     {
-        const std::string pathStr = path.string();
-
-        Slang::ComPtr<slang::IBlob> diagnostics;
-        slang::IModule*             module;
+        slang::IModule* module = nullptr;
         {
-            module = m_implementation->session->loadModule(pathStr.c_str(), diagnostics.writeRef());
-            if (!module)
-            {
-                vzt::logger::error("[SLANG] Compile Error, diagnostic {}",
-                                   reinterpret_cast<const char*>(diagnostics->getBufferPointer()));
-                std::abort();
-            }
+            std::lock_guard lock{m_implementation->sessionMutex};
+            module = loadModule(m_implementation->session, path);
         }
 
         Module result         = {};
-        result.implementation = std::make_unique<Module::Implementation>(module);
+        result.implementation = std::make_unique<Module::Implementation>(module, path);
 
         return result;
     }
@@ -0,0 +1,98 @@
+#include "vzt/core/thread_pool.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace vzt
+{
+    ThreadPool::ThreadPool(uint32_t threadNb)
+    {
+        // hardware_concurrency may not be computable
+        threadNb = std::max(threadNb, 1u);
+
+        m_threads.reserve(threadNb);
+        for (uint32_t i = 0; i < threadNb; i++)
+            m_threads.emplace_back(&ThreadPool::work, this, i);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock{m_mutex};
+            m_stop = true;
+        }
+        m_condition.notify_all();
+
+        for (auto& thread : m_threads)
+            thread.join();
+    }
+
+    void ThreadPool::submit(Task task)
+    {
+        {
+            std::lock_guard lock{m_mutex};
+            m_tasks.emplace(std::move(task));
+        }
+        m_condition.notify_one();
+    }
+
+    void ThreadPool::parallelFor(uint32_t count, const std::function<void(uint32_t i, uint32_t threadId)>& task)
+    {
+        std::mutex              mutex;
+        std::condition_variable done;
+        uint32_t                remaining = count;
+        std::exception_ptr      exception;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            submit([&, i](uint32_t threadId) {
+                // Exceptions are forwarded to the calling thread rather than terminating the worker
+                std::exception_ptr current;
+                try
+                {
+                    task(i, threadId);
+                }
+                catch (...)
+                {
+                    current = std::current_exception();
+                }
+
+                // Notified under the lock so that the waiting thread cannot leave before the notification
+                std::lock_guard lock{mutex};
+                if (current && !exception)
+                    exception = current;
+
+                if (--remaining == 0)
+                    done.notify_one();
+            });
+        }
+
+        {
+            std::unique_lock lock{mutex};
+            done.wait(lock, [&remaining] { return remaining == 0; });
+        }
+
+        // Every task is complete, the first failure is rethrown
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+    void ThreadPool::work(uint32_t threadId)
+    {
+        while (true)
+        {
+            Task task;
+            {
+                std::unique_lock lock{m_mutex};
+                m_condition.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+                if (m_stop && m_tasks.empty())
+                    return;
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+            }
+
+            task(threadId);
+        }
+    }
+} // namespace vzt
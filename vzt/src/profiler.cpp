@@ -0,0 +1,123 @@
+#include "vzt/profiler.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include "vzt/core/assert.hpp"
+
+namespace vzt
+{
+    GpuProfiler::GpuProfiler(View<Device> device, uint32_t frameNb, uint32_t maxScopeNb, uint32_t historySize)
+        : m_maxScopeNb(maxScopeNb), m_historySize(std::max(historySize, 1u))
+    {
+        m_period = device->getHardware().getProperties().limits.timestampPeriod;
+
+        m_frames.reserve(frameNb);
+        for (uint32_t i = 0; i < frameNb; i++)
+        {
+            Frame frame{};
+            frame.pool = QueryPool(device, QueryType::Timestamp, maxScopeNb * 2);
+            m_frames.emplace_back(std::move(frame));
+        }
+    }
+
+    void GpuProfiler::begin(uint32_t frameId, CommandBuffer& commands)
+    {
+        VZT_ASSERT(frameId < m_frames.size());
+
+        collect(frameId);
+
+        Frame& frame = m_frames[frameId];
+        frame.scopes.clear();
+        frame.opened.clear();
+        frame.pending = true;
+
+        commands.reset(frame.pool, 0, m_maxScopeNb * 2);
+        m_current = frameId;
+    }
+
+    void GpuProfiler::beginScope(std::string_view name, CommandBuffer& commands)
+    {
+        Frame& frame = m_frames[m_current];
+        VZT_ASSERT(frame.scopes.size() < m_maxScopeNb);
+
+        const auto scopeId = static_cast<uint32_t>(frame.scopes.size());
+        frame.scopes.emplace_back(name);
+        frame.opened.emplace_back(scopeId);
+
+        commands.writeTimeStamp(frame.pool, scopeId * 2, PipelineStage::BottomOfPipe);
+    }
+
+    void GpuProfiler::endScope(CommandBuffer& commands)
+    {
+        Frame& frame = m_frames[m_current];
+        VZT_ASSERT(!frame.opened.empty());
+
+        const uint32_t scopeId = frame.opened.back();
+        frame.opened.pop_back();
+
+        commands.writeTimeStamp(frame.pool, scopeId * 2 + 1, PipelineStage::BottomOfPipe);
+    }
+
+    Optional<TimingStatistics> GpuProfiler::getStatistics(std::string_view name) const
+    {
+        const auto history = m_histories.find(std::string(name));
+        if (history == m_histories.end() || history->second.samples.empty())
+            return {};
+
+        std::vector<float> samples = history->second.samples;
+        std::sort(samples.begin(), samples.end());
+
+        const auto percentile = [&samples](float p) {
+            const auto id = static_cast<std::size_t>(p * static_cast<float>(samples.size() - 1) + .5f);
+            return samples[id];
+        };
+
+        TimingStatistics statistics{};
+        statistics.last     = history->second.last;
+        statistics.min      = samples.front();
+        statistics.max      = samples.back();
+        statistics.average  = std::accumulate(samples.begin(), samples.end(), 0.f) / static_cast<float>(samples.size());
+        statistics.p50      = percentile(.50f);
+        statistics.p95      = percentile(.95f);
+        statistics.p99      = percentile(.99f);
+        statistics.sampleNb = static_cast<uint32_t>(samples.size());
+
+        return statistics;
+    }
+
+    void GpuProfiler::collect(uint32_t frameId)
+    {
+        Frame& frame = m_frames[frameId];
+        if (!frame.pending || frame.scopes.empty())
+            return;
+
+        // Pairs of (timestamp, availability)
+        const auto            queryNb = static_cast<uint32_t>(frame.scopes.size() * 2);
+        std::vector<uint64_t> results(queryNb * 2);
+        frame.pool.getResults(0, queryNb, Span<uint64_t>(results), sizeof(uint64_t) * 2,
+                              QueryResultFlag::N64 | QueryResultFlag::WithAvailability);
+
+        for (std::size_t i = 0; i < frame.scopes.size(); i++)
+        {
+            const uint64_t* begin = results.data() + i * 4;
+            const uint64_t* end   = begin + 2;
+            if (begin[1] == 0 || end[1] == 0 || end[0] < begin[0])
+                continue;
+
+            const float ms = static_cast<float>(end[0] - begin[0]) * m_period / 1e6f;
+
+            History& history = m_histories[frame.scopes[i]];
+            history.last     = ms;
+            if (history.samples.size() < m_historySize)
+            {
+                history.samples.emplace_back(ms);
+            }
+            else
+            {
+                history.samples[history.next] = ms;
+                history.next                  = (history.next + 1) % m_historySize;
+            }
+        }
+    }
+} // namespace vzt
@@ -1,5 +1,6 @@
 #include "vzt/render_graph.hpp"
 
+#include <algorithm>
 #include <bitset>
 #include <numeric>
 #include <stdexcept>
@@ -7,6 +8,7 @@
 
 #include "vzt/core/assert.hpp"
 #include "vzt/core/logger.hpp"
+#include "vzt/core/math.hpp"
 #include "vzt/vulkan/swapchain.hpp"
 
 namespace vzt
@@ -30,15 +32,12 @@ namespace vzt
         VZT_ASSERT(handle.type == HandleType::Storage);
 
         PassStorage storage{handle, name, range};
-        storage.waitAccess   = Access::ShaderWrite;
-        storage.waitStage    = PipelineStage::ComputeShader;
-        storage.targetAccess = Access::ShaderRead;
-        storage.targetStage  = PipelineStage::VertexShader;
-        storage.binding      = binding;
+        storage.access  = Access::ShaderRead;
+        storage.stage   = getShaderStages();
+        storage.binding = binding;
         if (storage.name.empty())
             storage.name = m_name + "StorageIn" + std::to_string(m_storageInputs.size());
 
-        storage.binding = binding;
         m_storageInputs.emplace_back(storage);
         m_descriptorLayout.addBinding(binding, DescriptorType::StorageBuffer);
     }
@@ -48,10 +47,8 @@ namespace vzt
         VZT_ASSERT(handle.type == HandleType::Storage);
 
         PassStorage storage{handle, name, range};
-        storage.waitAccess   = Access::ShaderWrite;
-        storage.waitStage    = PipelineStage::ComputeShader;
-        storage.targetAccess = Access::IndirectCommandRead;
-        storage.targetStage  = PipelineStage::DrawIndirect;
+        storage.access = Access::IndirectCommandRead;
+        storage.stage  = PipelineStage::DrawIndirect;
         if (storage.name.empty())
             storage.name = m_name + "StorageInIndirect" + std::to_string(m_storageInputs.size());
 
@@ -65,10 +62,8 @@ namespace vzt
         if (handle.type == HandleType::Storage)
         {
             PassStorage storage{handle, name, range};
-            storage.targetAccess = Access::ShaderWrite;
-            storage.targetStage  = PipelineStage::VertexShader | PipelineStage::ComputeShader;
-            storage.waitAccess   = Access::ShaderRead;
-            storage.waitStage    = PipelineStage::VertexInput | PipelineStage::ComputeShader;
+            storage.access = Access::ShaderWrite;
+            storage.stage  = getShaderStages();
             if (storage.name.empty())
                 storage.name = m_name + "StorageOut" + std::to_string(m_storageInputs.size());
 
@@ -79,10 +74,8 @@ namespace vzt
         else if (handle.type == HandleType::Attachment)
         {
             PassAttachment storage{handle, name};
-            storage.targetAccess = Access::ShaderWrite;
-            storage.targetStage  = PipelineStage::VertexShader | PipelineStage::ComputeShader;
-            storage.waitAccess   = Access::ShaderRead;
-            storage.waitStage    = PipelineStage::VertexInput | PipelineStage::ComputeShader;
+            storage.access = Access::ShaderWrite;
+            storage.stage  = getShaderStages();
             if (storage.name.empty())
                 storage.name = m_name + "StorageImageOut" + std::to_string(m_storageImageOutputs.size());
 
@@ -105,10 +98,8 @@ namespace vzt
         if (handle.type == HandleType::Storage)
         {
             PassStorage inStorage{handle, inName, range};
-            inStorage.targetAccess = Access::ShaderRead | Access::ShaderWrite;
-            inStorage.targetStage  = PipelineStage::VertexShader | PipelineStage::ComputeShader;
-            inStorage.waitAccess   = Access::ShaderRead | Access::ShaderWrite;
-            inStorage.waitStage    = PipelineStage::VertexInput | PipelineStage::ComputeShader;
+            inStorage.access = Access::ShaderRead | Access::ShaderWrite;
+            inStorage.stage  = getShaderStages();
             if (inStorage.name.empty())
                 inStorage.name = m_name + "StorageIn" + std::to_string(m_storageInputs.size());
 
@@ -116,6 +107,8 @@ namespace vzt
             m_storageInputs.emplace_back(inStorage);
 
             PassStorage outStorage{handle, outName, range};
+            outStorage.access = Access::ShaderRead | Access::ShaderWrite;
+            outStorage.stage  = getShaderStages();
             if (outStorage.name.empty())
                 outStorage.name = m_name + "StorageOut" + std::to_string(m_storageOutputs.size());
 
@@ -127,10 +120,8 @@ namespace vzt
         else if (handle.type == HandleType::Attachment)
         {
             PassAttachment storage{handle, inName};
-            storage.targetAccess = Access::ShaderWrite;
-            storage.targetStage  = PipelineStage::VertexShader | PipelineStage::ComputeShader;
-            storage.waitAccess   = Access::ShaderRead;
-            storage.waitStage    = PipelineStage::VertexInput | PipelineStage::ComputeShader;
+            storage.access = Access::ShaderRead | Access::ShaderWrite;
+            storage.stage  = getShaderStages();
             if (storage.name.empty())
                 storage.name = m_name + "StorageImageOut" + std::to_string(m_storageImageOutputs.size());
 
@@ -157,10 +148,8 @@ namespace vzt
         attachment.use.finalLayout = ImageLayout::ShaderReadOnlyOptimal;
         attachment.use.usedLayout  = ImageLayout::ShaderReadOnlyOptimal;
 
-        attachment.waitStage    = PipelineStage::ColorAttachmentOutput | PipelineStage::ComputeShader;
-        attachment.targetStage  = PipelineStage::ComputeShader;
-        attachment.waitAccess   = Access::ShaderWrite;
-        attachment.targetAccess = Access::ShaderRead;
+        attachment.access = Access::ShaderRead;
+        attachment.stage  = getShaderStages();
 
         m_textureInputs.emplace_back(attachment);
         m_descriptorLayout.addBinding(binding, DescriptorType::CombinedSampler);
@@ -178,11 +167,9 @@ namespace vzt
         attachment.use.finalLayout = ImageLayout::ShaderReadOnlyOptimal;
         attachment.use.usedLayout  = ImageLayout::ShaderReadOnlyOptimal;
 
-        attachment.waitStage    = PipelineStage::LateFragmentTests | PipelineStage::ComputeShader;
-        attachment.targetStage  = PipelineStage::ComputeShader;
-        attachment.waitAccess   = Access::DepthStencilAttachmentWrite | Access::ShaderWrite;
-        attachment.targetAccess = Access::ShaderRead;
-        attachment.aspect       = ImageAspect::Depth;
+        attachment.access = Access::ShaderRead;
+        attachment.stage  = getShaderStages();
+        attachment.aspect = ImageAspect::Depth;
 
         m_textureInputs.emplace_back(attachment);
         m_descriptorLayout.addBinding(binding, DescriptorType::CombinedSampler);
@@ -326,117 +313,13 @@ namespace vzt
 
     void Pass::record(uint32_t i, CommandBuffer& commands) const
     {
-        for (const auto& input : m_textureInputs)
-        {
-            ImageBarrier barrier;
-            barrier.image     = m_graph->getImage(i, input.handle);
-            barrier.oldLayout = input.use.initialLayout;
-            barrier.newLayout = input.use.usedLayout;
-            barrier.src       = input.waitAccess;
-            barrier.dst       = input.targetAccess;
-            barrier.aspect    = input.aspect;
-
-            const uint32_t mipLevel = m_graph->getConfiguration(input.handle).mipLevels;
-            barrier.baseLevel       = 0;
-            barrier.levelCount      = mipLevel;
-
-            // TODO: Handle many queues
-            // barrier.srcQueue
-            // barrier.dstQueue
-
-            commands.barrier(input.waitStage, input.targetStage, barrier);
-        }
-
-        for (const auto& input : m_colorInputs)
-        {
-            ImageBarrier barrier;
-            barrier.image     = m_graph->getImage(i, input.handle);
-            barrier.oldLayout = input.use.initialLayout;
-            barrier.newLayout = input.use.usedLayout;
-            barrier.src       = input.waitAccess;
-            barrier.dst       = input.targetAccess;
-            barrier.aspect    = input.aspect;
-
-            // TODO: Handle many queues
-            // barrier.srcQueue
-            // barrier.dstQueue
-
-            commands.barrier(input.waitStage, input.targetStage, barrier);
-        }
-
-        for (const auto& input : m_storageInputs)
-        {
-
-            const View<Buffer> buffer = m_graph->getStorage(i, input.handle);
-
-            BufferBarrier barrier;
-            barrier.buffer = {buffer, buffer->size()};
-            barrier.src    = input.waitAccess;
-            barrier.dst    = input.targetAccess;
-
-            // TODO: Handle many queues
-            // barrier.srcQueue
-            // barrier.dstQueue
-
-            commands.barrier(input.waitStage, input.targetStage, barrier);
-        }
-
-        for (const auto& output : m_colorOutputs)
-        {
-            ImageBarrier barrier;
-            barrier.image     = m_graph->getImage(i, output.handle);
-            barrier.oldLayout = output.use.initialLayout;
-            barrier.newLayout = output.use.usedLayout;
-            barrier.src       = output.waitAccess;
-            barrier.dst       = output.targetAccess;
-            barrier.aspect    = output.aspect;
-
-            // TODO: Handle many queues
-            // barrier.srcQueue
-            // barrier.dstQueue
-
-            commands.barrier(output.waitStage, output.targetStage, barrier);
-        }
-
-        for (const auto& output : m_storageImageOutputs)
-        {
-            ImageBarrier barrier;
-            barrier.image     = m_graph->getImage(i, output.handle);
-            barrier.oldLayout = output.use.initialLayout;
-            barrier.newLayout = output.use.usedLayout;
-            barrier.src       = output.waitAccess;
-            barrier.dst       = output.targetAccess;
-            barrier.aspect    = output.aspect;
-
-            const uint32_t mipLevel = m_graph->getConfiguration(output.handle).mipLevels;
-            barrier.baseLevel       = 0;
-            barrier.levelCount      = mipLevel;
-
-            // TODO: Handle many queues
-            // barrier.srcQueue
-            // barrier.dstQueue
+        const PipelineBarrier& barrier = m_pipelineBarriers[i];
+        if (!barrier.imageBarriers.empty() || !barrier.bufferBarriers.empty())
+            commands.barrier(barrier);
 
-            commands.barrier(output.waitStage, output.targetStage, barrier);
-        }
-
-        for (const auto& output : m_storageOutputs)
-        {
-            if (output.handle.state == 0)
-                continue;
-
-            const View<Buffer> buffer = m_graph->getStorage(i, output.handle);
-
-            BufferBarrier barrier;
-            barrier.buffer = {buffer, buffer->size()};
-            barrier.src    = output.waitAccess;
-            barrier.dst    = output.targetAccess;
-
-            // TODO: Handle many queues
-            // barrier.srcQueue
-            // barrier.dstQueue
-
-            commands.barrier(output.waitStage, output.targetStage, barrier);
-        }
+        // Barriers are kept so that following passes find their resources in the expected layouts
+        if (!m_ready && !m_hasFallback)
+            return;
 
         if (m_recordCallback)
             m_recordCallback->record(i, m_pool[i], commands);
@@ -462,7 +345,51 @@ namespace vzt
             output.use.format = attachmentBuilder.format.value_or(m_graph->getBackbufferFormat());
         }
 
-        m_colorOutputImageViews.reserve(m_colorOutputs.size() + m_graph->getBackbufferNb());
+        createViews();
+
+        // Create descriptors for the current pass
+        m_descriptorLayout.compile();
+
+        const uint32_t backbufferNb = m_graph->getBackbufferNb();
+
+        m_pool = DescriptorPool{device, m_descriptorLayout, backbufferNb};
+        m_pool.allocate(backbufferNb, m_descriptorLayout);
+
+        createDescriptors();
+        createBarriers();
+    }
+
+    void Pass::poll() {}
+
+    void Pass::resize()
+    {
+        // Views, descriptors and barriers of passes which only use kept resources remain valid
+        const auto isReallocated = [this](const auto& resource) {
+            return m_graph->m_reallocated.contains(resource.handle);
+        };
+
+        const bool isUsingReallocated =
+            std::any_of(m_storageInputs.begin(), m_storageInputs.end(), isReallocated) ||
+            std::any_of(m_storageOutputs.begin(), m_storageOutputs.end(), isReallocated) ||
+            std::any_of(m_textureInputs.begin(), m_textureInputs.end(), isReallocated) ||
+            std::any_of(m_storageImageOutputs.begin(), m_storageImageOutputs.end(), isReallocated) ||
+            std::any_of(m_colorInputs.begin(), m_colorInputs.end(), isReallocated) ||
+            std::any_of(m_colorOutputs.begin(), m_colorOutputs.end(), isReallocated) ||
+            (m_depthInput && isReallocated(*m_depthInput)) || (m_depthOutput && isReallocated(*m_depthOutput));
+        if (!isUsingReallocated)
+            return;
+
+        createViews();
+        createDescriptors();
+        createBarriers();
+    }
+
+    void Pass::createViews()
+    {
+        m_colorOutputImageViews.clear();
+        m_depthOutputImageViews.clear();
+
+        m_colorOutputImageViews.reserve(m_colorOutputs.size() * m_graph->getBackbufferNb());
         for (uint32_t i = 0; i < m_graph->getBackbufferNb(); i++)
         {
             for (const auto& output : m_colorOutputs)
@@ -477,24 +404,16 @@ namespace vzt
                     ImageView{m_graph->m_device, m_graph->getImage(i, m_depthOutput->handle), ImageAspect::Depth});
             }
         }
-        // Create descriptors for the current pass
-        m_descriptorLayout.compile();
-
-        const uint32_t backbufferNb = m_graph->getBackbufferNb();
-
-        m_pool = DescriptorPool{device, m_descriptorLayout, backbufferNb};
-        m_pool.allocate(backbufferNb, m_descriptorLayout);
-
-        createDescriptors();
     }
 
-    void Pass::resize() { createDescriptors(); }
-
     void Pass::createDescriptors()
     {
         const uint32_t backbufferNb = m_graph->getBackbufferNb();
         View<Device>   device       = m_graph->getDevice();
 
+        m_textureSaves.clear();
+        m_storageImageViews.clear();
+
         // Create views
         for (uint32_t i = 0; i < backbufferNb; i++)
         {
@@ -549,8 +468,8 @@ namespace vzt
                     input.use.format = *attachmentBuilder.format;
 
                 const auto& texture = m_textureSaves[i * m_textureInputs.size() + s];
-                descriptors[input.binding] =
-                    DescriptorImage{DescriptorType::CombinedSampler, texture.getView(), texture.getSampler()};
+                descriptors[input.binding] = DescriptorImage{DescriptorType::CombinedSampler, texture.getView(),
+                                                             texture.getSampler(), input.use.usedLayout};
             }
 
             // Storage image
@@ -587,16 +506,106 @@ namespace vzt
         }
     }
 
+    void Pass::createBarriers()
+    {
+        // Resources placed on memory previously used by other resources must wait for their last users
+        std::vector<PassBarrier> barriers{};
+        barriers.reserve(m_aliasingBarriers.size() + m_barriers.size());
+        for (const auto& aliasing : m_aliasingBarriers)
+        {
+            PassBarrier barrier{aliasing.handle};
+            barrier.srcStage  = PipelineStage::AllCommands;
+            barrier.srcAccess = Access::MemoryWrite;
+            barrier.dstStage  = PipelineStage::AllCommands;
+            barrier.dstAccess = Access::MemoryRead | Access::MemoryWrite;
+            barrier.oldLayout = ImageLayout::Undefined;
+            barrier.newLayout = aliasing.layout;
+            barriers.emplace_back(barrier);
+        }
+        barriers.insert(barriers.end(), m_barriers.begin(), m_barriers.end());
+
+        const uint32_t backbufferNb = m_graph->getBackbufferNb();
+
+        m_pipelineBarriers.clear();
+        m_pipelineBarriers.reserve(backbufferNb);
+        for (uint32_t i = 0; i < backbufferNb; i++)
+            m_pipelineBarriers.emplace_back(m_graph->getPipelineBarrier(i, barriers));
+    }
+
+    PipelineStage Pass::getShaderStages() const
+    {
+        if (m_type == PassType::Compute)
+            return PipelineStage::ComputeShader;
+
+        return PipelineStage::VertexShader | PipelineStage::FragmentShader;
+    }
+
+    static DescriptorLayout::Bindings getBindings(const Program& program)
+    {
+        DescriptorLayout::Bindings bindings;
+        for (const ShaderModule& module : program.getModules())
+        {
+            for (const auto [id, type] : module.getShader().bindings)
+                bindings[id] = type;
+        }
+
+        return bindings;
+    }
+
     ComputePass::ComputePass(RenderGraph& graph, std::string name, Program&& program)
-        : Pass(graph, std::move(name), PassType::Compute), m_program(std::move(program)), m_pipeline(m_program)
+        : Pass(graph, std::move(name), PassType::Compute), m_program(std::move(program))
     {
-        link(m_pipeline);
+        // Bindings are taken from the shaders rather than from a pipeline, which is only created at compilation
+        for (const auto [id, type] : getBindings(m_program))
+            m_descriptorLayout.addBinding(id, type);
+    }
+
+    void ComputePass::setFallback(Program&& program)
+    {
+        // Pipelines are bound with the descriptor sets of the pass, whose layout must be identical to theirs
+        VZT_ASSERT(getBindings(program) == getBindings(m_program) &&
+                   "Fallback bindings must be identical to the ones of the pass program.");
+
+        m_fallbackProgram = std::move(program);
+        m_hasFallback     = true;
     }
 
     void ComputePass::compile()
     {
         Pass::compile();
-        m_pipeline = ComputePipeline(m_program);
+
+        if (!m_graph->m_pipelineCompiler)
+        {
+            m_pipeline = ComputePipeline(m_program);
+            return;
+        }
+
+        if (m_hasFallback)
+            m_fallbackPipeline = ComputePipeline(m_fallbackProgram);
+
+        m_ready           = false;
+        m_pendingPipeline = m_graph->m_pipelineCompiler->compile(m_program);
+    }
+
+    void ComputePass::poll()
+    {
+        if (!AsyncPipelineCompiler::IsReady(m_pendingPipeline))
+            return;
+
+        try
+        {
+            m_pipeline = m_pendingPipeline.get();
+        }
+        catch (const std::exception& exception)
+        {
+            logger::error("[RenderGraph] Failed to create the pipeline of pass {}: {}", m_name, exception.what());
+            return;
+        }
+
+        // vkCheck only logs failures, the fallback keeps being used if no pipeline was created
+        m_ready = m_pipeline.getHandle() != VK_NULL_HANDLE;
+        if (!m_ready)
+            logger::error("[RenderGraph] Failed to create the pipeline of pass {}.", m_name);
     }
 
     void GraphicsPass::setDepthInput(const Handle& handle, std::string name)
@@ -611,6 +620,10 @@ namespace vzt
         attachment.use.usedLayout    = ImageLayout::DepthStencilAttachmentOptimal;
         attachment.use.finalLayout   = ImageLayout::DepthStencilAttachmentOptimal;
 
+        attachment.access = Access::DepthStencilAttachmentRead;
+        attachment.stage  = PipelineStage::EarlyFragmentTests | PipelineStage::LateFragmentTests;
+        attachment.aspect = ImageAspect::Depth;
+
         m_depthInput = attachment;
     }
 
@@ -626,6 +639,10 @@ namespace vzt
         attachment.use.usedLayout  = ImageLayout::DepthStencilAttachmentOptimal;
         attachment.use.finalLayout = ImageLayout::DepthStencilAttachmentOptimal;
 
+        attachment.access = Access::DepthStencilAttachmentRead | Access::DepthStencilAttachmentWrite;
+        attachment.stage  = PipelineStage::EarlyFragmentTests | PipelineStage::LateFragmentTests;
+        attachment.aspect = ImageAspect::Depth;
+
         m_depthOutput = attachment;
     }
 
@@ -641,6 +658,10 @@ namespace vzt
         attachment.use.usedLayout  = ImageLayout::DepthStencilAttachmentOptimal;
         attachment.use.finalLayout = ImageLayout::DepthStencilAttachmentOptimal;
 
+        attachment.access = Access::DepthStencilAttachmentRead | Access::DepthStencilAttachmentWrite;
+        attachment.stage  = PipelineStage::EarlyFragmentTests | PipelineStage::LateFragmentTests;
+        attachment.aspect = ImageAspect::Depth;
+
         m_depthInput  = attachment;
         m_depthOutput = attachment;
     }
@@ -654,11 +675,8 @@ namespace vzt
         if (attachment.name.empty())
             attachment.name = m_name + "ColorOut" + std::to_string(m_colorOutputs.size());
 
-        // Attachment is already used as output
-        attachment.waitStage    = PipelineStage::ColorAttachmentOutput | PipelineStage::ComputeShader;
-        attachment.targetStage  = PipelineStage::FragmentShader | PipelineStage::ComputeShader;
-        attachment.waitAccess   = Access::ColorAttachmentWrite | Access::ShaderWrite;
-        attachment.targetAccess = Access::ShaderRead | Access::ColorAttachmentRead;
+        attachment.access = Access::ColorAttachmentWrite;
+        attachment.stage  = PipelineStage::ColorAttachmentOutput;
 
         attachment.use.usedLayout  = ImageLayout::ColorAttachmentOptimal;
         attachment.use.finalLayout = ImageLayout::ColorAttachmentOptimal;
@@ -678,10 +696,8 @@ namespace vzt
         inAttachment.use.finalLayout = ImageLayout::ColorAttachmentOptimal;
         inAttachment.use.usedLayout  = ImageLayout::ColorAttachmentOptimal;
 
-        inAttachment.waitStage    = PipelineStage::ColorAttachmentOutput | PipelineStage::ComputeShader;
-        inAttachment.targetStage  = PipelineStage::FragmentShader | PipelineStage::ComputeShader;
-        inAttachment.waitAccess   = Access::ColorAttachmentWrite | Access::ShaderWrite;
-        inAttachment.targetAccess = Access::ShaderRead;
+        inAttachment.access = Access::ColorAttachmentRead;
+        inAttachment.stage  = PipelineStage::ColorAttachmentOutput;
 
         m_colorInputs.emplace_back(inAttachment);
 
@@ -693,6 +709,9 @@ namespace vzt
         outAttachment.use.usedLayout  = ImageLayout::ColorAttachmentOptimal;
         outAttachment.use.finalLayout = ImageLayout::ColorAttachmentOptimal;
 
+        outAttachment.access = Access::ColorAttachmentWrite;
+        outAttachment.stage  = PipelineStage::ColorAttachmentOutput;
+
         outAttachment.blend = std::move(blend);
         m_colorOutputs.emplace_back(outAttachment);
     }
@@ -722,11 +741,57 @@ namespace vzt
             m_graphicsPipelineBuilder.setDepth(depthFormat);
         }
 
-        m_pipeline = GraphicsPipeline(m_graphicsPipelineBuilder);
+        if (!m_graph->m_pipelineCompiler)
+        {
+            m_pipeline = GraphicsPipeline(m_graphicsPipelineBuilder);
+            return;
+        }
+
+        if (m_hasFallback)
+        {
+            GraphicsPipelineBuilder fallbackBuilder = m_graphicsPipelineBuilder;
+            fallbackBuilder.program                 = m_fallbackProgram;
+
+            m_fallbackPipeline = GraphicsPipeline(fallbackBuilder);
+        }
+
+        m_ready           = false;
+        m_pendingPipeline = m_graph->m_pipelineCompiler->compile(m_graphicsPipelineBuilder);
+    }
+
+    void GraphicsPass::setFallback(Program&& program)
+    {
+        // Pipelines are bound with the descriptor sets of the pass, whose layout must be identical to theirs
+        VZT_ASSERT(getBindings(program) == getBindings(m_program) &&
+                   "Fallback bindings must be identical to the ones of the pass program.");
+
+        m_fallbackProgram = std::move(program);
+        m_hasFallback     = true;
     }
 
     void GraphicsPass::resize() { Pass::resize(); }
 
+    void GraphicsPass::poll()
+    {
+        if (!AsyncPipelineCompiler::IsReady(m_pendingPipeline))
+            return;
+
+        try
+        {
+            m_pipeline = m_pendingPipeline.get();
+        }
+        catch (const std::exception& exception)
+        {
+            logger::error("[RenderGraph] Failed to create the pipeline of pass {}: {}", m_name, exception.what());
+            return;
+        }
+
+        // vkCheck only logs failures, the fallback keeps being used if no pipeline was created
+        m_ready = m_pipeline.getHandle() != VK_NULL_HANDLE;
+        if (!m_ready)
+            logger::error("[RenderGraph] Failed to create the pipeline of pass {}.", m_name);
+    }
+
     RenderGraph::RenderGraph(View<Device> device) : m_device(device) {}
 
     void RenderGraph::setBackbuffer(View<DeviceImage> image, ImageLayout finalLayout, Handle handle)
@@ -747,6 +812,7 @@ namespace vzt
         m_backbufferExtent = swapchain->getExtent();
         m_backbufferLayout = ImageLayout::PresentSrcKHR;
         m_backbuffer       = handle;
+        m_swapchain        = swapchain;
 
         for (uint32_t i = 0; i < m_backbufferNb; ++i)
             m_externalBackbuffers.emplace_back(swapchain->getImage(i));
@@ -768,9 +834,12 @@ namespace vzt
         return handle;
     }
 
+    void RenderGraph::exportHandle(const Handle& handle) { m_exports.emplace_back(handle); }
+
     ComputePass& RenderGraph::addCompute(std::string name, Program&& program)
     {
         ComputePass* pass = new ComputePass(*this, name, std::move(program));
+        pass->m_order = m_passes.size() + m_culledPasses.size();
         m_passes.emplace_back(pass);
         return *pass;
     }
@@ -778,6 +847,7 @@ namespace vzt
     ComputePass& RenderGraph::addCompute(std::string name, std::vector<Shader> shaders)
     {
         ComputePass* pass = new ComputePass(*this, name, Program(m_device, shaders));
+        pass->m_order = m_passes.size() + m_culledPasses.size();
         m_passes.emplace_back(pass);
         return *pass;
     }
@@ -790,6 +860,7 @@ namespace vzt
     GraphicsPass& RenderGraph::addGraphics(std::string name, Program&& program)
     {
         GraphicsPass* pass = new GraphicsPass(*this, name, std::move(program));
+        pass->m_order = m_passes.size() + m_culledPasses.size();
         m_passes.emplace_back(pass);
         return *pass;
     }
@@ -797,6 +868,7 @@ namespace vzt
     GraphicsPass& RenderGraph::addGraphics(std::string name, std::vector<Shader> shaders)
     {
         GraphicsPass* pass = new GraphicsPass(*this, name, Program(m_device, shaders));
+        pass->m_order = m_passes.size() + m_culledPasses.size();
         m_passes.emplace_back(pass);
         return *pass;
     }
@@ -814,6 +886,16 @@ namespace vzt
         // Back buffer must be set before compiling render graph
         VZT_ASSERT(m_backbuffer);
 
+        // Passes culled by a previous compilation may contribute to the outputs of the graph since then
+        for (auto& pass : m_culledPasses)
+            m_passes.emplace_back(std::move(pass));
+        m_culledPasses.clear();
+
+        std::sort(m_passes.begin(), m_passes.end(),
+                  [](const auto& a, const auto& b) { return a->m_order < b->m_order; });
+
+        cull();
+
         const std::vector<std::size_t>     executionOrder = sort();
         std::vector<std::unique_ptr<Pass>> sortedPasses{};
         sortedPasses.reserve(m_passes.size());
@@ -822,57 +904,158 @@ namespace vzt
             sortedPasses.emplace_back(std::move(m_passes[executionOrder[i]]));
         m_passes = std::move(sortedPasses);
 
-        // Get all use handles and find by which queue it is used
-        HandleMap<ImageLayout> handlesLastLayout{};
+        trackHazards();
+        createRenderTarget();
+        createAsyncSubmissions();
+        createRecordPools();
+
+        if (m_profiling)
+            m_profiler = GpuProfiler(m_device, m_backbufferNb, size() + 1);
 
-        const auto addAttachment = [&handlesLastLayout](Pass::PassAttachment& attachment) {
-            if (handlesLastLayout.find(attachment.handle) != handlesLastLayout.end())
-                attachment.use.initialLayout = handlesLastLayout[attachment.handle];
+        constexpr double MB = 1024. * 1024.;
+        logger::info("[RenderGraph] Memory footprint: {:.2f}MB requested, {:.2f}MB allocated with aliasing in {} "
+                     "allocations.",
+                     static_cast<double>(m_footprint.requested) / MB, static_cast<double>(m_footprint.allocated) / MB,
+                     m_footprint.allocationNb);
 
-            handlesLastLayout[attachment.handle] = attachment.use.usedLayout;
-        };
+        // Pending compilations of a previous compile() are completed before their passes are recompiled
+        m_pipelineCompiler.reset();
+        if (m_asyncPipelines)
+            m_pipelineCompiler = std::make_unique<AsyncPipelineCompiler>(m_pipelineCompilerThreadNb);
 
+        // Create render passes and their corresponding data such as the FrameBuffer
+        // Traverse pass in execution order to fit their id with their ressources
         for (auto& pass : m_passes)
+            pass->compile();
+    }
+
+    bool RenderGraph::isReady() const
+    {
+        return std::all_of(m_passes.begin(), m_passes.end(), [](const auto& pass) { return pass->isReady(); });
+    }
+
+    void RenderGraph::record(uint32_t i, CommandBuffer& commands)
+    {
+        pollPipelines();
+
+        if (m_profiling)
         {
-            for (auto& input : pass->m_colorInputs)
-                addAttachment(input);
+            m_profiler.begin(i, commands);
+            m_profiler.beginScope(ProfilerScope, commands);
+        }
 
-            for (auto& input : pass->m_textureInputs)
-                addAttachment(input);
+        if (!m_recordThreads)
+        {
+            for (auto& pass : m_passes)
+            {
+                if (pass->m_async)
+                    continue;
 
-            for (auto& output : pass->m_colorOutputs)
-                addAttachment(output);
+                if (m_profiling)
+                    m_profiler.beginScope(pass->getName(), commands);
 
-            for (auto& output : pass->m_storageImageOutputs)
-                addAttachment(output);
+                pass->record(i, commands);
 
-            if (pass->m_depthInput)
-                addAttachment(*pass->m_depthInput);
+                if (m_profiling)
+                    m_profiler.endScope(commands);
+            }
 
-            if (pass->m_depthOutput)
-                addAttachment(*pass->m_depthOutput);
+            if (m_profiling)
+                m_profiler.endScope(commands);
+
+            return;
         }
 
-        createRenderTarget();
+        // Passes are recorded in parallel and executed in their sorted order
+        const uint32_t                       passNb = size();
+        std::vector<Optional<CommandBuffer>> secondaries(passNb);
+        m_recordThreads->parallelFor(passNb, [&](uint32_t passId, uint32_t threadId) {
+            const auto& pass = m_passes[passId];
+            if (pass->m_async)
+                return;
 
-        // Create render passes and their corresponding data such as the FrameBuffer
-        // Traverse pass in execution order to fit their id with their ressources
-        for (auto& pass : m_passes)
-            pass->compile();
+            CommandBuffer secondary = m_recordPools[threadId][i * passNb + passId];
+            secondary.begin();
+            pass->record(i, secondary);
+            secondary.end();
+
+            secondaries[passId] = std::move(secondary);
+        });
+
+        std::vector<CommandBuffer> recorded{};
+        recorded.reserve(passNb);
+        for (uint32_t passId = 0; passId < passNb; passId++)
+        {
+            if (!secondaries[passId])
+                continue;
+
+            // Timestamps can only be written between secondary command buffers of the primary one
+            if (m_profiling)
+            {
+                m_profiler.beginScope(m_passes[passId]->getName(), commands);
+                commands.execute(*secondaries[passId]);
+                m_profiler.endScope(commands);
+                continue;
+            }
+
+            recorded.emplace_back(std::move(*secondaries[passId]));
+        }
+
+        if (!recorded.empty())
+            commands.execute(recorded);
+
+        if (m_profiling)
+            m_profiler.endScope(commands);
     }
 
-    void RenderGraph::record(uint32_t i, CommandBuffer& commands)
+    void RenderGraph::resize(const Extent2D& extent)
     {
+        m_backbufferExtent = extent;
+
+        // Swapchain images are recreated with the swapchain
+        if (m_swapchain)
+        {
+            VZT_ASSERT(m_swapchain->getImageNb() == m_backbufferNb);
+
+            m_externalBackbuffers.clear();
+            for (uint32_t i = 0; i < m_backbufferNb; ++i)
+                m_externalBackbuffers.emplace_back(m_swapchain->getImage(i));
+        }
+
+        createRenderTarget(true);
+        if (m_backbuffer)
+            m_reallocated.emplace(*m_backbuffer);
+
+        createAsyncSubmissions();
+
         for (auto& pass : m_passes)
-            pass->record(i, commands);
+            pass->resize();
     }
 
-    void RenderGraph::resize(const Extent2D&)
+    std::vector<SemaphoreWait> RenderGraph::submitAsync(uint32_t i)
     {
-        createRenderTarget();
+        if (m_asyncSemaphores.empty())
+            return {};
+
+        pollPipelines();
+
+        CommandBuffer commands = m_asyncCommandPool[i];
+        commands.begin();
 
         for (auto& pass : m_passes)
-            pass->resize();
+        {
+            if (pass->m_async)
+                pass->record(i, commands);
+        }
+
+        const PipelineBarrier& release = m_asyncReleases[i];
+        if (!release.imageBarriers.empty() || !release.bufferBarriers.empty())
+            commands.barrier(release);
+
+        commands.end();
+
+        m_asyncQueue->submit(commands, m_asyncSemaphores[i]);
+        return {SemaphoreWait{m_asyncSemaphores[i], m_asyncWaitStage}};
     }
 
     Handle RenderGraph::generateAttachmentHandle() const
@@ -899,171 +1082,1090 @@ namespace vzt
 
     const AttachmentBuilder& RenderGraph::getConfiguration(Handle handle) { return m_attachmentBuilders[handle]; }
 
-    std::vector<std::size_t> RenderGraph::sort()
+    std::vector<std::vector<std::size_t>> RenderGraph::getDependencies() const
     {
-        // Graph sorting based on its topology
-        // https://en.wikipedia.org/wiki/Topological_sorting
-        std::vector<std::size_t> executionOrder{};
-        executionOrder.reserve(m_passes.size());
-
-        // 0: unmarked, 1: temporary marked, 2: permanent mark
-        auto nodeStatus     = std::vector<std::size_t>(m_passes.size(), 0);
-        auto remainingNodes = std::vector<std::size_t>(m_passes.size());
-        std::iota(remainingNodes.begin(), remainingNodes.end(), 0);
-
-        std::function<void(std::size_t)> processNode = [&](std::size_t idx) {
-            const std::size_t currentStatus = nodeStatus[idx];
-
-            if (currentStatus == 1)
-                throw std::runtime_error("The render graph is cyclic.");
-            if (currentStatus == 2)
-                return;
+        // Passes producing each version of a resource, by kind of output
+        struct Version
+        {
+            std::size_t id;
+            std::size_t state;
 
-            nodeStatus[idx] = 1;
+            bool operator==(const Version& other) const = default;
+        };
 
-            const auto& currentRenderPass = m_passes[idx];
-            for (std::size_t j = 0; j < m_passes.size(); j++)
+        struct VersionHash
+        {
+            std::size_t operator()(const Version& version) const
             {
-                if (j == idx)
-                    continue;
-
-                if (currentRenderPass->isDependingOn(*m_passes[j]))
-                    processNode(j);
+                return version.id ^ (version.state + 0x9e3779b9 + (version.id << 6) + (version.id >> 2));
             }
-
-            nodeStatus[idx] = 2;
-            executionOrder.emplace_back(idx);
-            remainingNodes.erase(std::remove(remainingNodes.begin(), remainingNodes.end(), idx), remainingNodes.end());
         };
 
-        while (!remainingNodes.empty())
-            processNode(remainingNodes.front());
+        using Producers = std::unordered_map<Version, std::vector<std::size_t>, VersionHash>;
+        Producers storageProducers{};
+        Producers storageImageProducers{};
+        Producers colorProducers{};
+        Producers depthProducers{};
 
-        if (executionOrder.size() <= 2)
-            return executionOrder;
-
-        // Try to schedule passes based on dependers and dependees
-        // Based on https://github.com/Themaister/Granite/blob/master/renderer/render_graph.cpp#L2886
-
-        // Expecting that m_sortedRenderPassIndices contains the sorted list of render pass indices.
-        std::vector<std::size_t> toProcess;
-        toProcess.reserve(executionOrder.size());
-        std::swap(toProcess, executionOrder);
-
-        const auto schedule = [&](unsigned index) {
-            // Need to preserve the order of remaining elements.
-            executionOrder.push_back(toProcess[index]);
-            toProcess.erase(toProcess.begin() + index);
+        const auto produce = [](Producers& producers, const Handle& handle, std::size_t passId) {
+            producers[{handle.id, handle.state}].emplace_back(passId);
         };
 
-        schedule(0);
-        while (!toProcess.empty())
+        for (std::size_t i = 0; i < m_passes.size(); i++)
         {
-            std::size_t bestCandidateIdx  = 0;
-            std::size_t bestOverlapFactor = 0;
+            const auto& pass = m_passes[i];
+            for (const auto& output : pass->m_storageOutputs)
+                produce(storageProducers, output.handle, i);
+            for (const auto& output : pass->m_storageImageOutputs)
+                produce(storageImageProducers, output.handle, i);
+            for (const auto& output : pass->m_colorOutputs)
+                produce(colorProducers, output.handle, i);
+            if (pass->m_depthOutput)
+                produce(depthProducers, pass->m_depthOutput->handle, i);
+        }
 
-            for (std::size_t i = 0; i < toProcess.size(); i++)
-            {
-                std::size_t overlapFactor = 0;
+        // Same relations as Pass::isDependingOn, resolved with one lookup per pass resource
+        std::vector<std::vector<std::size_t>> dependencies(m_passes.size());
+        for (std::size_t i = 0; i < m_passes.size(); i++)
+        {
+            std::vector<std::size_t>& passDependencies = dependencies[i];
 
-                // Try to find the farthest non-depending pass
-                for (auto it = executionOrder.rbegin(); it != executionOrder.rend(); ++it)
-                {
-                    if (m_passes[toProcess[i]]->isDependingOn(*m_passes[*it]))
-                        break;
+            const auto consume = [&](const Producers& producers, const Handle& handle) {
+                const auto it = producers.find({handle.id, handle.state});
+                if (it == producers.end())
+                    return;
 
-                    overlapFactor++;
+                for (const std::size_t producer : it->second)
+                {
+                    if (producer != i)
+                        passDependencies.emplace_back(producer);
                 }
+            };
+
+            const auto consumeImage = [&](const Handle& handle) {
+                consume(storageImageProducers, handle);
+                consume(colorProducers, handle);
+                consume(depthProducers, handle);
+            };
+
+            const auto& pass = m_passes[i];
+            for (const auto& input : pass->m_storageInputs)
+                consume(storageProducers, input.handle);
+            for (const auto& output : pass->m_storageOutputs)
+                consume(storageProducers, output.handle);
+
+            for (const auto& input : pass->m_textureInputs)
+                consumeImage(input.handle);
+            for (const auto& output : pass->m_storageImageOutputs)
+                consumeImage(output.handle);
+            for (const auto& input : pass->m_colorInputs)
+                consumeImage(input.handle);
+
+            for (const auto& output : pass->m_colorOutputs)
+            {
+                consume(storageImageProducers, output.handle);
+                consume(colorProducers, output.handle);
+            }
 
-                if (overlapFactor <= bestOverlapFactor)
-                    continue;
+            if (pass->m_depthInput)
+                consume(depthProducers, pass->m_depthInput->handle);
 
-                bool possibleCandidate = true;
-                for (std::size_t j = 0; j < i; j++)
-                {
-                    if (m_passes[toProcess[i]]->isDependingOn(*m_passes[toProcess[j]]))
-                    {
-                        possibleCandidate = false;
-                        break;
-                    }
-                }
+            std::sort(passDependencies.begin(), passDependencies.end());
+            passDependencies.erase(std::unique(passDependencies.begin(), passDependencies.end()),
+                                   passDependencies.end());
+        }
 
-                if (!possibleCandidate)
-                    continue;
+        return dependencies;
+    }
 
-                bestCandidateIdx  = i;
+    bool RenderGraph::isOutput(const Handle& handle) const
+    {
+        if (m_backbuffer && m_backbuffer->id == handle.id)
+            return true;
+
+        const auto exported = std::find_if(m_exports.begin(), m_exports.end(),
+                                           [&handle](const Handle& other) { return other.id == handle.id; });
+        if (exported != m_exports.end())
+            return true;
+
+        // Host visible resources are considered as read back by the application
+        if (handle.type == HandleType::Storage)
+            return m_storageBuilders.at(handle).mappable;
+
+        return m_attachmentBuilders.at(handle).mappable;
+    }
+
+    void RenderGraph::cull()
+    {
+        if (!m_culling)
+            return;
+
+        const auto writesOutput = [this](const Pass& pass) {
+            const auto isPassOutput = [this](const auto& output) { return isOutput(output.handle); };
+            return std::any_of(pass.m_storageOutputs.begin(), pass.m_storageOutputs.end(), isPassOutput) ||
+                   std::any_of(pass.m_storageImageOutputs.begin(), pass.m_storageImageOutputs.end(), isPassOutput) ||
+                   std::any_of(pass.m_colorOutputs.begin(), pass.m_colorOutputs.end(), isPassOutput) ||
+                   (pass.m_depthOutput && isPassOutput(*pass.m_depthOutput));
+        };
+
+        // Walk backward from the passes writing the outputs of the graph
+        const std::vector<std::vector<std::size_t>> dependencies = getDependencies();
+
+        std::vector<bool>        contributes(m_passes.size(), false);
+        std::vector<std::size_t> toVisit{};
+        for (std::size_t i = 0; i < m_passes.size(); i++)
+        {
+            if (!writesOutput(*m_passes[i]))
+                continue;
+
+            contributes[i] = true;
+            toVisit.emplace_back(i);
+        }
+
+        while (!toVisit.empty())
+        {
+            const std::size_t passId = toVisit.back();
+            toVisit.pop_back();
+
+            for (const std::size_t dependency : dependencies[passId])
+            {
+                if (contributes[dependency])
+                    continue;
+
+                contributes[dependency] = true;
+                toVisit.emplace_back(dependency);
+            }
+        }
+
+        std::vector<std::unique_ptr<Pass>> passes{};
+        passes.reserve(m_passes.size());
+        for (std::size_t i = 0; i < m_passes.size(); i++)
+        {
+            if (contributes[i])
+            {
+                passes.emplace_back(std::move(m_passes[i]));
+                continue;
+            }
+
+            logger::info("[RenderGraph] Pass {} does not contribute to any output and is culled.",
+                         m_passes[i]->getName());
+            m_culledPasses.emplace_back(std::move(m_passes[i]));
+        }
+        m_passes = std::move(passes);
+    }
+
+    std::vector<std::size_t> RenderGraph::sort()
+    {
+        const std::vector<std::vector<std::size_t>> dependencies = getDependencies();
+
+        // Graph sorting based on its topology
+        // https://en.wikipedia.org/wiki/Topological_sorting
+        std::vector<std::size_t> executionOrder{};
+        executionOrder.reserve(m_passes.size());
+
+        // 0: unmarked, 1: temporary marked, 2: permanent mark
+        auto nodeStatus = std::vector<std::size_t>(m_passes.size(), 0);
+
+        std::function<void(std::size_t)> processNode = [&](std::size_t idx) {
+            const std::size_t currentStatus = nodeStatus[idx];
+
+            if (currentStatus == 1)
+                throw std::runtime_error("The render graph is cyclic.");
+            if (currentStatus == 2)
+                return;
+
+            nodeStatus[idx] = 1;
+
+            for (const std::size_t dependency : dependencies[idx])
+                processNode(dependency);
+
+            nodeStatus[idx] = 2;
+            executionOrder.emplace_back(idx);
+        };
+
+        for (std::size_t i = 0; i < m_passes.size(); i++)
+            processNode(i);
+
+        if (executionOrder.size() <= 2)
+            return executionOrder;
+
+        // Try to schedule passes based on dependers and dependees
+        // Based on https://github.com/Themaister/Granite/blob/master/renderer/render_graph.cpp#L2886
+
+        // Expecting that toProcess contains the sorted list of render pass indices.
+        std::vector<std::size_t> toProcess;
+        toProcess.reserve(executionOrder.size());
+        std::swap(toProcess, executionOrder);
+
+        // Position of scheduled passes in the execution order
+        constexpr std::size_t    Unscheduled = std::numeric_limits<std::size_t>::max();
+        std::vector<std::size_t> positions(m_passes.size(), Unscheduled);
+
+        const auto schedule = [&](std::size_t passId) {
+            positions[passId] = executionOrder.size();
+            executionOrder.emplace_back(passId);
+        };
+
+        schedule(toProcess[0]);
+        while (executionOrder.size() < toProcess.size())
+        {
+            Optional<std::size_t> bestCandidate{};
+            std::size_t           bestOverlapFactor = 0;
+
+            for (const std::size_t candidate : toProcess)
+            {
+                if (positions[candidate] != Unscheduled)
+                    continue;
+
+                // Default to the first remaining pass, whose dependencies are all scheduled
+                if (!bestCandidate)
+                    bestCandidate = candidate;
+
+                // Try to find the farthest non-depending pass
+                bool        ready          = true;
+                std::size_t lastDependency = Unscheduled;
+                for (const std::size_t dependency : dependencies[candidate])
+                {
+                    if (positions[dependency] == Unscheduled)
+                        ready = false;
+                    else if (lastDependency == Unscheduled || positions[dependency] > lastDependency)
+                        lastDependency = positions[dependency];
+                }
+
+                const std::size_t overlapFactor = lastDependency == Unscheduled
+                                                      ? executionOrder.size()
+                                                      : executionOrder.size() - 1 - lastDependency;
+                if (overlapFactor <= bestOverlapFactor || !ready)
+                    continue;
+
+                bestCandidate     = candidate;
                 bestOverlapFactor = overlapFactor;
             }
 
-            executionOrder.emplace_back(toProcess[bestCandidateIdx]);
-            toProcess.erase(toProcess.begin() + static_cast<long>(bestCandidateIdx));
+            schedule(*bestCandidate);
         }
 
         return executionOrder;
     }
 
-    void RenderGraph::createRenderTarget()
+    HandleMap<RenderGraph::ResourceLifetime> RenderGraph::getLifetimes() const
+    {
+        HandleMap<ResourceLifetime> lifetimes{};
+
+        const auto use = [this, &lifetimes](std::size_t passId, const Handle& handle, bool read, ImageLayout layout) {
+            auto it         = lifetimes.try_emplace(handle, ResourceLifetime{passId, passId, read, layout}).first;
+            it->second.last = passId;
+            it->second.async |= m_passes[passId]->m_async;
+        };
+
+        for (std::size_t i = 0; i < m_passes.size(); i++)
+        {
+            const auto& pass = m_passes[i];
+
+            // Inputs first to detect resources whose first access reads them
+            for (const auto& input : pass->m_storageInputs)
+                use(i, input.handle, true, ImageLayout::Undefined);
+
+            for (const auto& input : pass->m_textureInputs)
+                use(i, input.handle, true, input.use.usedLayout);
+
+            for (const auto& input : pass->m_colorInputs)
+                use(i, input.handle, true, input.use.usedLayout);
+
+            if (pass->m_depthInput)
+                use(i, pass->m_depthInput->handle, true, pass->m_depthInput->use.usedLayout);
+
+            for (const auto& output : pass->m_storageOutputs)
+                use(i, output.handle, false, ImageLayout::Undefined);
+
+            for (const auto& output : pass->m_storageImageOutputs)
+                use(i, output.handle, false, output.use.usedLayout);
+
+            for (const auto& output : pass->m_colorOutputs)
+                use(i, output.handle, false, output.use.usedLayout);
+
+            if (pass->m_depthOutput)
+                use(i, pass->m_depthOutput->handle, false, pass->m_depthOutput->use.usedLayout);
+        }
+
+        return lifetimes;
+    }
+
+    PipelineBarrier RenderGraph::getPipelineBarrier(uint32_t backbufferId, CSpan<PassBarrier> barriers) const
+    {
+        PipelineBarrier batch{PipelineStage::None, PipelineStage::None};
+
+        // Accesses to the same resource within the pass are merged in a single barrier to perform one transition.
+        // Stages are kept per barrier so that they are not widened to the whole batch with Synchronization2.
+        for (const auto& barrier : barriers)
+        {
+            if (barrier.handle.type == HandleType::Attachment)
+            {
+                const View<DeviceImage> image = getImage(backbufferId, barrier.handle);
+
+                auto it = std::find_if(batch.imageBarriers.begin(), batch.imageBarriers.end(),
+                                       [&image](const ImageBarrier& existing) {
+                                           return existing.image.get() == image.get();
+                                       });
+                if (it != batch.imageBarriers.end())
+                {
+                    it->newLayout = barrier.newLayout;
+
+                    it->src |= barrier.srcAccess;
+                    it->dst |= barrier.dstAccess;
+                    it->srcStage |= barrier.srcStage;
+                    it->dstStage |= barrier.dstStage;
+                    continue;
+                }
+
+                const AttachmentBuilder& configuration = m_attachmentBuilders.at(barrier.handle);
+                const bool               isDepth = any(configuration.usage & ImageUsage::DepthStencilAttachment);
+
+                ImageBarrier imageBarrier;
+                imageBarrier.image      = image;
+                imageBarrier.oldLayout  = barrier.oldLayout;
+                imageBarrier.newLayout  = barrier.newLayout;
+                imageBarrier.srcQueue   = barrier.srcQueue;
+                imageBarrier.dstQueue   = barrier.dstQueue;
+                imageBarrier.src        = barrier.srcAccess;
+                imageBarrier.dst        = barrier.dstAccess;
+                imageBarrier.levelCount = configuration.mipLevels;
+                imageBarrier.aspect     = isDepth ? ImageAspect::Depth : ImageAspect::Color;
+                imageBarrier.srcStage   = barrier.srcStage;
+                imageBarrier.dstStage   = barrier.dstStage;
+                batch.imageBarriers.emplace_back(std::move(imageBarrier));
+            }
+            else
+            {
+                const View<Buffer> buffer = getStorage(backbufferId, barrier.handle);
+
+                auto it = std::find_if(batch.bufferBarriers.begin(), batch.bufferBarriers.end(),
+                                       [&buffer](const BufferBarrier& existing) {
+                                           return existing.buffer.buffer == buffer.get();
+                                       });
+                if (it != batch.bufferBarriers.end())
+                {
+                    it->src |= barrier.srcAccess;
+                    it->dst |= barrier.dstAccess;
+                    it->srcStage |= barrier.srcStage;
+                    it->dstStage |= barrier.dstStage;
+                    continue;
+                }
+
+                BufferBarrier bufferBarrier;
+                bufferBarrier.buffer   = {buffer, buffer->size()};
+                bufferBarrier.src      = barrier.srcAccess;
+                bufferBarrier.dst      = barrier.dstAccess;
+                bufferBarrier.srcQueue = barrier.srcQueue;
+                bufferBarrier.dstQueue = barrier.dstQueue;
+                bufferBarrier.srcStage = barrier.srcStage;
+                bufferBarrier.dstStage = barrier.dstStage;
+                batch.bufferBarriers.emplace_back(std::move(bufferBarrier));
+            }
+        }
+
+        return batch;
+    }
+
+    void RenderGraph::trackHazards()
+    {
+        // Access of a pass to a resource, merged when the resource is used several times by the pass
+        struct ResourceAccess
+        {
+            Handle        handle;
+            PipelineStage stage;
+            Access        access;
+            ImageLayout   layout;
+        };
+
+        // Synchronization state of a resource after the last visited pass
+        struct ResourceState
+        {
+            PipelineStage writeStage  = PipelineStage::None;
+            Access        writeAccess = Access::None;
+            PipelineStage readStages  = PipelineStage::None; // Reads performed since the last write
+            Access        readAccess  = Access::None;
+            ImageLayout   layout      = ImageLayout::Undefined;
+            bool          async       = false; // Last accessed on the compute queue
+        };
+
+        constexpr Access WriteAccesses = Access::ShaderWrite | Access::ColorAttachmentWrite |
+                                         Access::DepthStencilAttachmentWrite | Access::TransferWrite |
+                                         Access::HostWrite | Access::MemoryWrite;
+
+        std::vector<std::vector<ResourceAccess>> passAccesses{};
+        passAccesses.reserve(m_passes.size());
+        for (const auto& pass : m_passes)
+        {
+            std::vector<ResourceAccess> accesses{};
+
+            const auto add = [&accesses](const Handle& handle, PipelineStage stage, Access access, ImageLayout layout) {
+                auto it = std::find_if(accesses.begin(), accesses.end(),
+                                       [&handle](const ResourceAccess& current) { return current.handle == handle; });
+                if (it == accesses.end())
+                {
+                    accesses.emplace_back(ResourceAccess{handle, stage, access, layout});
+                    return;
+                }
+
+                it->stage |= stage;
+                it->access |= access;
+
+                // A single layout must suit every use of the pass
+                if (it->layout != layout)
+                    it->layout = ImageLayout::General;
+            };
+
+            for (const auto& input : pass->m_storageInputs)
+                add(input.handle, input.stage, input.access, ImageLayout::Undefined);
+
+            for (const auto& input : pass->m_textureInputs)
+                add(input.handle, input.stage, input.access, input.use.usedLayout);
+
+            for (const auto& input : pass->m_colorInputs)
+                add(input.handle, input.stage, input.access, input.use.usedLayout);
+
+            if (pass->m_depthInput)
+            {
+                const auto& input = *pass->m_depthInput;
+                add(input.handle, input.stage, input.access, input.use.usedLayout);
+            }
+
+            for (const auto& output : pass->m_storageOutputs)
+                add(output.handle, output.stage, output.access, ImageLayout::Undefined);
+
+            for (const auto& output : pass->m_storageImageOutputs)
+                add(output.handle, output.stage, output.access, output.use.usedLayout);
+
+            for (const auto& output : pass->m_colorOutputs)
+                add(output.handle, output.stage, output.access, output.use.usedLayout);
+
+            if (pass->m_depthOutput)
+            {
+                const auto& output = *pass->m_depthOutput;
+                add(output.handle, output.stage, output.access, output.use.usedLayout);
+            }
+
+            // Uses of attachments accessed with different layouts follow the resolved one, such as descriptors
+            const auto resolve = [&accesses](auto& attachment) {
+                const auto it = std::find_if(accesses.begin(), accesses.end(), [&](const ResourceAccess& current) {
+                    return current.handle == attachment.handle;
+                });
+                if (it->layout != ImageLayout::General)
+                    return;
+
+                attachment.use.usedLayout  = ImageLayout::General;
+                attachment.use.finalLayout = ImageLayout::General;
+            };
+
+            std::for_each(pass->m_textureInputs.begin(), pass->m_textureInputs.end(), resolve);
+            std::for_each(pass->m_colorInputs.begin(), pass->m_colorInputs.end(), resolve);
+            std::for_each(pass->m_storageImageOutputs.begin(), pass->m_storageImageOutputs.end(), resolve);
+            std::for_each(pass->m_colorOutputs.begin(), pass->m_colorOutputs.end(), resolve);
+            if (pass->m_depthInput)
+                resolve(*pass->m_depthInput);
+            if (pass->m_depthOutput)
+                resolve(*pass->m_depthOutput);
+
+            passAccesses.emplace_back(std::move(accesses));
+        }
+
+        // Resources read before being written keep their content across frames, so their first reader waits for
+        // the last writer of the graph and images start from the layout of their last use. Other images start from an
+        // undefined layout at each frame.
+        const HandleMap<ResourceLifetime> lifetimes = getLifetimes();
+
+        HandleMap<ResourceState> states{};
+        for (const auto& accesses : passAccesses)
+        {
+            for (const auto& current : accesses)
+            {
+                if (!lifetimes.at(current.handle).preserved)
+                    continue;
+
+                ResourceState& state = states[current.handle];
+                if (any(current.access & WriteAccesses))
+                {
+                    state.writeStage  = current.stage;
+                    state.writeAccess = current.access & WriteAccesses;
+                }
+
+                state.layout = current.layout;
+            }
+        }
+
+        m_preservedLayouts.clear();
+        for (const auto& [handle, state] : states)
+        {
+            if (handle.type == HandleType::Attachment)
+                m_preservedLayouts.emplace(handle, state.layout);
+        }
+
+        // Compute passes which neither access resources previously used by the graphics queue in the frame nor
+        // content preserved across frames are moved to the compute queue
+        const View<Queue> graphicsQueue = m_device->getQueue(QueueType::Graphics);
+        m_asyncQueue                    = getAsyncQueue();
+
+        m_releaseBarriers.clear();
+        m_asyncWaitStage = PipelineStage::None;
+        for (std::size_t i = 0; i < m_passes.size(); i++)
+        {
+            Pass& pass = *m_passes[i];
+            pass.m_barriers.clear();
+
+            const auto& accesses = passAccesses[i];
+            pass.m_async = m_asyncQueue && pass.m_type == PassType::Compute &&
+                           std::none_of(accesses.begin(), accesses.end(), [&](const ResourceAccess& current) {
+                               const auto state = states.find(current.handle);
+                               return (state != states.end() && !state->second.async) ||
+                                      lifetimes.at(current.handle).preserved;
+                           });
+
+            for (const auto& current : accesses)
+            {
+                ResourceState& state = states[current.handle];
+
+                const bool isWrite    = any(current.access & WriteAccesses);
+                const bool transition = current.handle.type == HandleType::Attachment && state.layout != current.layout;
+
+                PassBarrier barrier{current.handle};
+                barrier.dstStage  = current.stage;
+                barrier.dstAccess = current.access;
+                barrier.oldLayout = state.layout;
+                barrier.newLayout = current.layout;
+
+                if (state.async && !pass.m_async)
+                {
+                    // Ownership transfer: released by the compute queue after the async passes and acquired by the
+                    // first graphics pass accessing the resource, which waits for the async submission
+                    PassBarrier release = barrier;
+                    release.srcStage    = state.writeStage | state.readStages;
+                    release.srcAccess   = state.writeAccess;
+                    release.dstStage    = PipelineStage::None;
+                    release.dstAccess   = Access::None;
+                    release.srcQueue    = m_asyncQueue;
+                    release.dstQueue    = graphicsQueue;
+                    m_releaseBarriers.emplace_back(release);
+
+                    barrier.srcQueue = m_asyncQueue;
+                    barrier.dstQueue = graphicsQueue;
+                    pass.m_barriers.emplace_back(barrier);
+
+                    m_asyncWaitStage |= current.stage;
+
+                    if (isWrite)
+                        state = {current.stage, current.access & WriteAccesses, PipelineStage::None, Access::None,
+                                 current.layout};
+                    else
+                        state = {current.stage, state.writeAccess, current.stage, current.access, current.layout};
+                    continue;
+                }
+
+                if (isWrite || transition)
+                {
+                    // Previous reads must be done before overwriting the resource or changing its layout
+                    barrier.srcStage  = state.writeStage | state.readStages;
+                    barrier.srcAccess = state.writeAccess;
+                }
+                else if (any(state.writeAccess))
+                {
+                    // Read after read does not require any synchronization if the write is already visible
+                    const bool visible = (state.readStages & current.stage) == current.stage &&
+                                         (state.readAccess & current.access) == current.access;
+                    if (!visible)
+                    {
+                        barrier.srcStage  = state.writeStage;
+                        barrier.srcAccess = state.writeAccess;
+                    }
+                }
+
+                // Transitions of resources without previous access are chained with the consumer stage so that
+                // they are ordered after semaphore waits, such as the swapchain image acquisition
+                if (transition && barrier.srcStage == PipelineStage::None)
+                    barrier.srcStage = current.stage;
+
+                if (barrier.srcStage != PipelineStage::None)
+                    pass.m_barriers.emplace_back(barrier);
+
+                if (isWrite)
+                {
+                    state = {current.stage, current.access & WriteAccesses, PipelineStage::None, Access::None,
+                             current.layout};
+                }
+                else if (transition)
+                {
+                    state.readStages = current.stage;
+                    state.readAccess = current.access;
+                    state.layout     = current.layout;
+                }
+                else
+                {
+                    state.readStages |= current.stage;
+                    state.readAccess |= current.access;
+                }
+
+                state.async = pass.m_async;
+            }
+        }
+
+        // Without ownership transfer, the graphics submission waits for the whole async submission
+        if (m_asyncWaitStage == PipelineStage::None)
+            m_asyncWaitStage = PipelineStage::AllCommands;
+    }
+
+    void RenderGraph::createRenderTarget(bool extentOnly)
     {
-        m_images.clear();
-        m_storages.clear();
-        m_handleToPhysical.clear();
+        // On resize, only images whose size is derived from the backbuffer extent are recreated. Other resources keep
+        // their memory and content.
+        if (!extentOnly)
+        {
+            m_images.clear();
+            m_storages.clear();
+            m_memory.clear();
+            m_extentMemory.clear();
+            m_handleToPhysical.clear();
+            m_memoryRequirements.clear();
+        }
+
+        m_footprint = {};
+        m_reallocated.clear();
+
+        for (auto& pass : m_passes)
+            pass->m_aliasingBarriers.clear();
+
+        // Resources which are not accessed by any pass are not created
+        const HandleMap<ResourceLifetime> lifetimes = getLifetimes();
+        const auto isUsed = [&](const Handle& handle) { return lifetimes.contains(handle) || isOutput(handle); };
+
+        const auto isExtentDependent = [this](const Handle& handle) {
+            return handle.type == HandleType::Attachment && !m_attachmentBuilders.at(handle).size;
+        };
+
+        // Querying requirements creates and destroys a temporary resource, which is avoided on resize for resources
+        // whose size does not depend on the backbuffer extent
+        const auto getRequirements = [&](const Handle& handle, const auto& query) {
+            if (isExtentDependent(handle))
+                return query();
+
+            auto it = m_memoryRequirements.find(handle);
+            if (it == m_memoryRequirements.end())
+                it = m_memoryRequirements.emplace(handle, query()).first;
+
+            return it->second;
+        };
 
         // Create physical memory (Image, Buffer)
         auto       hardware    = m_device->getHardware();
         const auto depthFormat = hardware.getDepthFormat();
 
-        std::size_t imageId   = 0;
-        std::size_t storageId = 0;
-
-        for (const auto& [handle, builder] : m_attachmentBuilders)
+        HandleMap<ImageBuilder> imageBuilders{};
+        for (auto& [handle, attachmentBuilder] : m_attachmentBuilders)
         {
             VZT_ASSERT(handle.type == HandleType::Attachment);
-            AttachmentBuilder& attachmentBuilder = m_attachmentBuilders[handle];
+            if (!isUsed(handle))
+                continue;
 
             // Swapchain images does not need to be created
-            if (attachmentBuilder.format || attachmentBuilder.usage != ImageUsage::ColorAttachment)
+            if (!attachmentBuilder.format && attachmentBuilder.usage == ImageUsage::ColorAttachment)
+                continue;
+
+            if (!attachmentBuilder.format && any(attachmentBuilder.usage & ImageUsage::DepthStencilAttachment))
+                attachmentBuilder.format = depthFormat;
+
+            ImageBuilder imageBuilder = {
+                .size        = attachmentBuilder.size.value_or(m_backbufferExtent),
+                .usage       = attachmentBuilder.usage,
+                .format      = *attachmentBuilder.format,
+                .mipLevels   = attachmentBuilder.mipLevels,
+                .sampleCount = attachmentBuilder.sampleCount,
+                .type        = attachmentBuilder.type,
+                .sharingMode = SharingMode::Exclusive,
+                .tiling      = attachmentBuilder.tiling,
+                .mappable    = attachmentBuilder.mappable,
+            };
+
+            imageBuilders.emplace(handle, imageBuilder);
+        }
+
+        // Find resources which can share memory based on their lifetime in the sorted pass list
+        struct AliasedResource
+        {
+            Handle             handle;
+            MemoryRequirements requirements;
+            ResourceLifetime   lifetime;
+            bool               extentDependent;
+        };
+
+        std::vector<AliasedResource> resources{};
+
+        for (const auto& [handle, imageBuilder] : imageBuilders)
+        {
+            const MemoryRequirements requirements = getRequirements(handle, [this, &builder = imageBuilder] {
+                return DeviceImage::getMemoryRequirements(m_device, builder);
+            });
+            m_footprint.requested += requirements.size * m_backbufferNb;
+
+            const AttachmentBuilder& attachmentBuilder = m_attachmentBuilders[handle];
+            const auto               lifetime          = lifetimes.find(handle);
+
+            const bool isBackbuffer = m_backbuffer && m_backbuffer->id == handle.id;
+            const bool aliasable    = m_aliasing && attachmentBuilder.transient && !attachmentBuilder.mappable &&
+                                   attachmentBuilder.tiling == ImageTiling::Optimal && !isBackbuffer &&
+                                   lifetime != lifetimes.end() && !lifetime->second.preserved &&
+                                   !lifetime->second.async;
+
+            if (aliasable)
             {
-                if (!attachmentBuilder.format && any(attachmentBuilder.usage & ImageUsage::DepthStencilAttachment))
-                    attachmentBuilder.format = depthFormat;
-
-                m_handleToPhysical[handle] = imageId;
-                imageId++;
-
-                ImageBuilder imageBuilder = {
-                    .size        = attachmentBuilder.size.value_or(m_backbufferExtent),
-                    .usage       = attachmentBuilder.usage,
-                    .format      = *attachmentBuilder.format,
-                    .mipLevels   = attachmentBuilder.mipLevels,
-                    .sampleCount = attachmentBuilder.sampleCount,
-                    .type        = attachmentBuilder.type,
-                    .sharingMode = attachmentBuilder.sharingMode,
-                    .tiling      = attachmentBuilder.tiling,
-                    .mappable    = attachmentBuilder.mappable,
-                };
-
-                imageBuilder.sampleCount = attachmentBuilder.sampleCount;
-                imageBuilder.sharingMode = SharingMode::Exclusive;
-
-                for (uint32_t i = 0; i < m_backbufferNb; i++)
-                    m_images.emplace_back(m_device, imageBuilder);
+                resources.emplace_back(
+                    AliasedResource{handle, requirements, lifetime->second, isExtentDependent(handle)});
+            }
+            else
+            {
+                m_footprint.allocated += requirements.size * m_backbufferNb;
+                m_footprint.allocationNb += m_backbufferNb;
             }
         }
 
-        for (const auto& [handle, queues] : m_storageBuilders)
+        for (const auto& [handle, storageBuilder] : m_storageBuilders)
         {
             VZT_ASSERT(handle.type == HandleType::Storage);
+            if (!isUsed(handle))
+                continue;
+
+            const MemoryRequirements requirements = getRequirements(handle, [this, &builder = storageBuilder] {
+                return Buffer::getMemoryRequirements(m_device, builder.size, builder.usage);
+            });
+            m_footprint.requested += requirements.size * m_backbufferNb;
+
+            const auto lifetime  = lifetimes.find(handle);
+            const bool aliasable = m_aliasing && storageBuilder.transient && !storageBuilder.mappable &&
+                                   storageBuilder.location == MemoryLocation::Device &&
+                                   lifetime != lifetimes.end() && !lifetime->second.preserved &&
+                                   !lifetime->second.async;
+
+            if (aliasable)
+            {
+                resources.emplace_back(AliasedResource{handle, requirements, lifetime->second, false});
+            }
+            else
+            {
+                m_footprint.allocated += requirements.size * m_backbufferNb;
+                m_footprint.allocationNb += m_backbufferNb;
+            }
+        }
+
+        // Largest resources first so that they define the size of the memory blocks. Ties are broken by handle so
+        // that the placement of fixed size resources is the same on resize.
+        std::sort(resources.begin(), resources.end(), [](const AliasedResource& a, const AliasedResource& b) {
+            if (a.requirements.size != b.requirements.size)
+                return a.requirements.size > b.requirements.size;
+            return a.handle.id < b.handle.id;
+        });
+
+        const auto areAlive = [](const ResourceLifetime& a, const ResourceLifetime& b) {
+            return a.first <= b.last && b.first <= a.last;
+        };
+
+        struct MemoryBlock
+        {
+            bool                     images;
+            bool                     extentDependent;
+            MemoryRequirements       requirements;
+            std::vector<std::size_t> resources;
+        };
+
+        struct Placement
+        {
+            std::size_t block;
+            uint64_t    offset;
+        };
+
+        std::vector<MemoryBlock> blocks{};
+        std::vector<Placement>   placements(resources.size());
+        for (std::size_t r = 0; r < resources.size(); r++)
+        {
+            const AliasedResource& resource = resources[r];
+            const bool             isImage  = resource.handle.type == HandleType::Attachment;
+            const uint64_t         size     = resource.requirements.size;
+
+            // Images and buffers are never mixed to avoid bufferImageGranularity conflicts. Extent dependent resources
+            // are not mixed with fixed size ones so that their blocks can be reallocated alone on resize.
+            Optional<Placement> placement{};
+            for (std::size_t b = 0; !placement && b < blocks.size(); b++)
+            {
+                const MemoryBlock& block = blocks[b];
+                if (block.images != isImage || block.extentDependent != resource.extentDependent ||
+                    !(block.requirements.memoryTypeBits & resource.requirements.memoryTypeBits))
+                    continue;
+
+                // Try the start of the block and the end of every resource alive at the same time
+                std::vector<uint64_t> candidates = {0};
+                for (const std::size_t other : block.resources)
+                {
+                    if (!areAlive(resources[other].lifetime, resource.lifetime))
+                        continue;
+
+                    const uint64_t end = placements[other].offset + resources[other].requirements.size;
+                    candidates.emplace_back(align(end, resource.requirements.alignment));
+                }
+                std::sort(candidates.begin(), candidates.end());
+
+                for (const uint64_t offset : candidates)
+                {
+                    if (offset + size > block.requirements.size)
+                        break;
+
+                    bool isFree = true;
+                    for (const std::size_t other : block.resources)
+                    {
+                        if (!areAlive(resources[other].lifetime, resource.lifetime))
+                            continue;
+
+                        const uint64_t otherStart = placements[other].offset;
+                        const uint64_t otherEnd   = otherStart + resources[other].requirements.size;
+                        if (offset < otherEnd && otherStart < offset + size)
+                        {
+                            isFree = false;
+                            break;
+                        }
+                    }
+
+                    if (isFree)
+                    {
+                        placement = Placement{b, offset};
+                        break;
+                    }
+                }
+            }
+
+            if (!placement)
+            {
+                placement = Placement{blocks.size(), 0};
+                blocks.emplace_back(MemoryBlock{isImage, resource.extentDependent, resource.requirements, {}});
+            }
+
+            MemoryBlock& block           = blocks[placement->block];
+            block.requirements.alignment = std::max(block.requirements.alignment, resource.requirements.alignment);
+            block.requirements.memoryTypeBits &= resource.requirements.memoryTypeBits;
+
+            placements[r] = *placement;
+            block.resources.emplace_back(r);
+        }
+
+        // The first pass using a resource must wait for previous users of the same memory range
+        for (std::size_t r = 0; r < resources.size(); r++)
+        {
+            const AliasedResource& resource = resources[r];
+            const uint64_t         start    = placements[r].offset;
+            const uint64_t         end      = start + resource.requirements.size;
+
+            for (const std::size_t other : blocks[placements[r].block].resources)
+            {
+                const uint64_t otherStart = placements[other].offset;
+                const uint64_t otherEnd   = otherStart + resources[other].requirements.size;
+                if (start < otherEnd && otherStart < end && resources[other].lifetime.last < resource.lifetime.first)
+                {
+                    m_passes[resource.lifetime.first]->m_aliasingBarriers.emplace_back(
+                        Pass::PassAliasing{resource.handle, resource.lifetime.layout});
+                    break;
+                }
+            }
+        }
+
+        // Blocks are stored by group, [groupBlockId * backbufferNb + backbufferId]
+        std::vector<std::size_t>  groupBlockIds(blocks.size());
+        std::vector<DeviceMemory> extentMemory{};
+        std::size_t               fixedBlockNb  = 0;
+        std::size_t               extentBlockNb = 0;
+        for (std::size_t b = 0; b < blocks.size(); b++)
+        {
+            const MemoryBlock& block = blocks[b];
+            m_footprint.allocated += block.requirements.size * m_backbufferNb;
+            m_footprint.allocationNb += m_backbufferNb;
+
+            groupBlockIds[b] = block.extentDependent ? extentBlockNb++ : fixedBlockNb++;
+            if (extentOnly && !block.extentDependent)
+                continue;
+
+            std::vector<DeviceMemory>& memory = block.extentDependent ? extentMemory : m_memory;
+            for (uint32_t i = 0; i < m_backbufferNb; i++)
+                memory.emplace_back(m_device, block.requirements);
+        }
+
+        const auto getMemory = [&](const Placement& placement, uint32_t i) -> const DeviceMemory& {
+            const std::size_t memoryId = groupBlockIds[placement.block] * m_backbufferNb + i;
+            return blocks[placement.block].extentDependent ? extentMemory[memoryId] : m_memory[memoryId];
+        };
+
+        HandleMap<Placement> handleToPlacement{};
+        for (std::size_t r = 0; r < resources.size(); r++)
+            handleToPlacement.emplace(resources[r].handle, placements[r]);
+
+        std::size_t imageId = 0;
+        if (!extentOnly)
+            m_images.resize(imageBuilders.size() * m_backbufferNb);
+
+        PipelineBarrier initialization{PipelineStage::TopOfPipe, PipelineStage::AllCommands};
+
+        for (const auto& [handle, imageBuilder] : imageBuilders)
+        {
+            if (extentOnly && !isExtentDependent(handle))
+                continue;
+
+            if (!extentOnly)
+                m_handleToPhysical[handle] = imageId++;
+
+            const std::size_t physicalId = m_handleToPhysical[handle];
+            m_reallocated.emplace(handle);
+
+            // Replaced images release their previous memory placement
+            const auto placement = handleToPlacement.find(handle);
+            for (uint32_t i = 0; i < m_backbufferNb; i++)
+            {
+                DeviceImage& image = m_images[physicalId * m_backbufferNb + i];
+                if (placement == handleToPlacement.end())
+                {
+                    image = DeviceImage(m_device, imageBuilder);
+                    continue;
+                }
+
+                const DeviceMemory& memory = getMemory(placement->second, i);
+                image                      = DeviceImage(m_device, imageBuilder, memory, placement->second.offset);
+            }
+
+            // Preserved images are first accessed as if they were left by a previous frame
+            const auto preserved = m_preservedLayouts.find(handle);
+            if (preserved == m_preservedLayouts.end() || preserved->second == ImageLayout::Undefined)
+                continue;
+
+            const bool isDepth = any(imageBuilder.usage & ImageUsage::DepthStencilAttachment);
+            for (uint32_t i = 0; i < m_backbufferNb; i++)
+            {
+                ImageBarrier barrier{};
+                barrier.image      = m_images[physicalId * m_backbufferNb + i];
+                barrier.oldLayout  = ImageLayout::Undefined;
+                barrier.newLayout  = preserved->second;
+                barrier.dst        = Access::MemoryRead | Access::MemoryWrite;
+                barrier.levelCount = imageBuilder.mipLevels;
+                barrier.aspect     = isDepth ? ImageAspect::Depth : ImageAspect::Color;
+                initialization.imageBarriers.emplace_back(std::move(barrier));
+            }
+        }
+
+        if (!initialization.imageBarriers.empty())
+        {
+            m_device->getQueue(QueueType::Graphics)->oneShot([&initialization](CommandBuffer& commands) {
+                commands.barrier(initialization);
+            });
+        }
+
+        // Previous extent dependent blocks are freed once no image is placed on them anymore
+        m_extentMemory = std::move(extentMemory);
+        if (extentOnly)
+            return;
+
+        std::size_t storageId = 0;
+        m_storages.reserve(m_storageBuilders.size() * m_backbufferNb);
+        for (const auto& [handle, storageBuilder] : m_storageBuilders)
+        {
+            if (!isUsed(handle))
+                continue;
+
             m_handleToPhysical[handle] = storageId;
             storageId++;
 
-            const StorageBuilder& storageBuilder = m_storageBuilders[handle];
+            const auto placement = handleToPlacement.find(handle);
             for (uint32_t i = 0; i < m_backbufferNb; i++)
-                m_storages.emplace_back(Buffer{
-                    m_device,
-                    storageBuilder.size,
-                    storageBuilder.usage,
-                    storageBuilder.location,
-                    storageBuilder.mappable,
-                });
+            {
+                if (placement == handleToPlacement.end())
+                {
+                    m_storages.emplace_back(Buffer{
+                        m_device,
+                        storageBuilder.size,
+                        storageBuilder.usage,
+                        storageBuilder.location,
+                        storageBuilder.mappable,
+                    });
+                    continue;
+                }
+
+                m_storages.emplace_back(m_device, storageBuilder.size, storageBuilder.usage,
+                                        getMemory(placement->second, i), placement->second.offset);
+            }
+        }
+    }
+
+    View<Queue> RenderGraph::getAsyncQueue() const
+    {
+        if (!m_asyncCompute)
+            return {};
+
+        // Only a queue of another family than the graphics one runs concurrently
+        const View<Queue> graphicsQueue = m_device->getQueue(QueueType::Graphics);
+        for (const View<Queue> queue : m_device->getQueues())
+        {
+            if (queue->getType() == QueueType::Compute && queue->getId() != graphicsQueue->getId())
+                return queue;
+        }
+
+        return {};
+    }
+
+    void RenderGraph::createAsyncSubmissions()
+    {
+        m_asyncReleases.clear();
+
+        const bool hasAsyncPass =
+            std::any_of(m_passes.begin(), m_passes.end(), [](const auto& pass) { return pass->m_async; });
+        if (!hasAsyncPass)
+        {
+            m_asyncSemaphores.clear();
+            m_asyncCommandPool = {};
+            return;
         }
+
+        if (m_asyncSemaphores.size() != m_backbufferNb)
+        {
+            m_asyncCommandPool = CommandPool(m_device, m_asyncQueue, m_backbufferNb);
+
+            m_asyncSemaphores.clear();
+            m_asyncSemaphores.reserve(m_backbufferNb);
+            for (uint32_t i = 0; i < m_backbufferNb; i++)
+                m_asyncSemaphores.emplace_back(m_device);
+        }
+
+        // Resources may have been recreated, so are their release barriers
+        m_asyncReleases.reserve(m_backbufferNb);
+        for (uint32_t i = 0; i < m_backbufferNb; i++)
+            m_asyncReleases.emplace_back(getPipelineBarrier(i, m_releaseBarriers));
+    }
+
+    void RenderGraph::createRecordPools()
+    {
+        m_recordPools.clear();
+        m_recordThreads.reset();
+        if (m_recordThreadNb < 2)
+            return;
+
+        m_recordThreads = std::make_unique<ThreadPool>(m_recordThreadNb);
+
+        // Command pools cannot be used concurrently, so each thread owns one holding a buffer for every pass since
+        // any thread may record any pass
+        const View<Queue> queue    = m_device->getQueue(QueueType::Graphics);
+        const uint32_t    bufferNb = m_backbufferNb * size();
+
+        m_recordPools.reserve(m_recordThreadNb);
+        for (uint32_t t = 0; t < m_recordThreadNb; t++)
+            m_recordPools.emplace_back(m_device, queue, bufferNb, CommandBufferLevel::Secondary);
+    }
+
+    void RenderGraph::pollPipelines()
+    {
+        // Passes are polled from the calling thread since record functions may run concurrently
+        if (!m_pipelineCompiler)
+            return;
+
+        for (auto& pass : m_passes)
+            pass->poll();
     }
 } // namespace vzt
@@ -3,6 +3,7 @@
 #include "vzt/core/assert.hpp"
 #include "vzt/vulkan/command.hpp"
 #include "vzt/vulkan/device.hpp"
+#include "vzt/vulkan/upload.hpp"
 
 namespace vzt
 {
@@ -11,12 +12,12 @@ namespace vzt
         VmaAllocationCreateFlags flags = 0;
 
         if (mappable)
-            flags |= VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+            flags |= VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
 
         return flags;
     }
 
-    VkMemoryPropertyFlags toVma(MemoryLocation location)
+    VmaMemoryUsage toVma(MemoryLocation location)
     {
         if (location == MemoryLocation::Host)
             return VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
@@ -30,31 +31,54 @@ namespace vzt
         VZT_ASSERT(data.size > 0);
         if (mappable)
         {
-            Buffer   buffer     = {device, data.size, usages, location, mappable};
-            uint8_t* bufferData = buffer.map();
-            std::memcpy(bufferData, data.data, data.size);
-            buffer.unMap();
+            Buffer buffer = {device, data.size, usages, location, mappable};
+            std::memcpy(buffer.map(), data.data, data.size);
+            buffer.flush();
 
             return buffer;
         }
 
-        Buffer buffer         = {device, data.size, usages | BufferUsage::TransferDst, location, mappable};
-        Buffer transferBuffer = {device, data.size, BufferUsage::TransferSrc, MemoryLocation::Host, true};
+        UploadToken token  = 0;
+        Buffer      buffer = FromAsync(device, data, usages, token, location);
+
+        // Only waits for the batch holding this copy instead of the whole transfer queue
+        if (token != 0)
+            device->getUploadManager().wait(token);
+
+        return buffer;
+    }
+
+    Buffer Buffer::FromAsync(View<Device> device, CSpan<uint8_t> data, BufferUsage usages, UploadToken& token,
+                             MemoryLocation location)
+    {
+        VZT_ASSERT(data.size > 0);
+
+        // Host visible memory is only mapped when VMA selected it, such as device local memory with ReBAR or on UMA
+        // systems. The data is then written directly instead of being staged.
+        VmaAllocationCreateFlags flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+        flags |= VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        Buffer buffer = {device, data.size, usages | BufferUsage::TransferDst, location, false, flags};
+        if (buffer.m_mapped)
         {
-            uint8_t* tempStagingData = transferBuffer.map();
-            std::memcpy(tempStagingData, data.data, data.size);
-            transferBuffer.unMap();
-        }
+            std::memcpy(buffer.m_mapped, data.data, data.size);
+            buffer.flush();
 
-        const View<Queue> queue = device->getQueue(QueueType::Transfer);
-        queue->oneShot([&transferBuffer, &buffer, &data](CommandBuffer& commands) {
-            commands.copy(transferBuffer, buffer, data.size);
-        });
+            token = 0;
+            return buffer;
+        }
 
+        token = device->getUploadManager().upload(data, buffer);
         return buffer;
     }
 
     Buffer::Buffer(View<Device> device, std::size_t byteNb, BufferUsage usages, MemoryLocation location, bool mappable)
+        : Buffer(device, byteNb, usages, location, mappable, toVma(mappable))
+    {
+    }
+
+    Buffer::Buffer(View<Device> device, std::size_t byteNb, BufferUsage usages, MemoryLocation location, bool mappable,
+                   VmaAllocationCreateFlags flags)
         : DeviceObject<VkBuffer>(device), m_size(byteNb), m_location(location), m_usages(usages), m_mappable(mappable)
     {
         VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
@@ -65,50 +89,131 @@ namespace vzt
             bufferInfo.usage |= toVulkan(BufferUsage::TransferDst);
 
         VmaAllocationCreateInfo allocInfo = {};
-        allocInfo.usage                   = VMA_MEMORY_USAGE_AUTO;
-        allocInfo.flags                   = toVma(mappable);
-        allocInfo.preferredFlags          = toVma(location);
+        allocInfo.usage                   = toVma(location);
+        allocInfo.flags                   = flags;
 
-        vkCheck(vmaCreateBuffer(m_device->getAllocator(), &bufferInfo, &allocInfo, &m_handle, &m_allocation, nullptr),
+        VmaAllocationInfo allocationInfo{};
+        vkCheck(vmaCreateBuffer(m_device->getAllocator(), &bufferInfo, &allocInfo, &m_handle, &m_allocation,
+                                &allocationInfo),
                 "Failed to create vertex buffer!");
+
+        m_mapped = static_cast<uint8_t*>(allocationInfo.pMappedData);
+    }
+
+    Buffer::Buffer(View<Device> device, std::size_t byteNb, BufferUsage usages, const DeviceMemory& memory,
+                   uint64_t offset)
+        : DeviceObject<VkBuffer>(device), m_size(byteNb), m_location(MemoryLocation::Device), m_usages(usages),
+          m_mappable(false), m_aliased(true)
+    {
+        VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+        bufferInfo.size               = m_size;
+        bufferInfo.sharingMode        = VK_SHARING_MODE_EXCLUSIVE;
+        bufferInfo.usage              = toVulkan(m_usages | BufferUsage::TransferDst);
+
+        vkCheck(vmaCreateAliasingBuffer2(m_device->getAllocator(), memory.getHandle(), offset, &bufferInfo, &m_handle),
+                "Failed to create aliased buffer!");
     }
 
     Buffer::Buffer(Buffer&& other) noexcept : DeviceObject<VkBuffer>(std::move(other))
     {
         std::swap(m_allocation, other.m_allocation);
+        std::swap(m_mapped, other.m_mapped);
         std::swap(m_size, other.m_size);
         std::swap(m_location, other.m_location);
         std::swap(m_usages, other.m_usages);
         std::swap(m_mappable, other.m_mappable);
+        std::swap(m_aliased, other.m_aliased);
+        std::swap(m_movable, other.m_movable);
+
+        updateOwner();
     }
 
     Buffer& Buffer::operator=(Buffer&& other) noexcept
     {
         std::swap(m_allocation, other.m_allocation);
+        std::swap(m_mapped, other.m_mapped);
         std::swap(m_size, other.m_size);
         std::swap(m_location, other.m_location);
         std::swap(m_usages, other.m_usages);
         std::swap(m_mappable, other.m_mappable);
+        std::swap(m_aliased, other.m_aliased);
+        std::swap(m_movable, other.m_movable);
 
         DeviceObject<VkBuffer>::operator=(std::move(other));
+
+        updateOwner();
+        other.updateOwner();
+
         return *this;
     }
 
     Buffer::~Buffer()
     {
-        if (m_handle != VK_NULL_HANDLE)
-            vmaDestroyBuffer(m_device->getAllocator(), m_handle, m_allocation);
+        if (m_handle == VK_NULL_HANDLE)
+            return;
+
+        // Aliased buffers only own their handle, not the memory they are placed on
+        if (m_aliased)
+        {
+            const VolkDeviceTable& table = m_device->getFunctionTable();
+            table.vkDestroyBuffer(m_device->getHandle(), m_handle, nullptr);
+            return;
+        }
+
+        vmaDestroyBuffer(m_device->getAllocator(), m_handle, m_allocation);
     }
 
     uint8_t* Buffer::map() const
     {
+        if (m_mapped)
+            return m_mapped;
+
         uint8_t* data = nullptr;
         vmaMapMemory(m_device->getAllocator(), m_allocation, reinterpret_cast<void**>(&data));
 
         return data;
     }
 
-    void Buffer::unMap() const { vmaUnmapMemory(m_device->getAllocator(), m_allocation); }
+    void Buffer::unMap() const
+    {
+        if (m_mapped)
+        {
+            flush();
+            return;
+        }
+
+        vmaUnmapMemory(m_device->getAllocator(), m_allocation);
+    }
+
+    void Buffer::flush(uint64_t offset, uint64_t size) const
+    {
+        vkCheck(vmaFlushAllocation(m_device->getAllocator(), m_allocation, offset, size), "Failed to flush buffer.");
+    }
+
+    void Buffer::invalidate(uint64_t offset, uint64_t size) const
+    {
+        vkCheck(vmaInvalidateAllocation(m_device->getAllocator(), m_allocation, offset, size),
+                "Failed to invalidate buffer.");
+    }
+
+    void Buffer::setMovable(bool movable)
+    {
+        VZT_ASSERT(!movable || (!m_mappable && !m_aliased && any(m_usages & BufferUsage::TransferSrc)));
+
+        // Persistently mapped buffers (such as From ones on ReBAR or UMA memory) would keep pointing to the previous
+        // allocation once moved
+        VZT_ASSERT(!movable || m_mapped == nullptr);
+
+        m_movable = movable;
+        if (m_allocation != VK_NULL_HANDLE)
+            vmaSetAllocationUserData(m_device->getAllocator(), m_allocation, m_movable ? this : nullptr);
+    }
+
+    void Buffer::updateOwner()
+    {
+        if (m_movable && m_allocation != VK_NULL_HANDLE)
+            vmaSetAllocationUserData(m_device->getAllocator(), m_allocation, this);
+    }
 
     uint64_t Buffer::getDeviceAddress() const
     {
@@ -119,4 +224,22 @@ namespace vzt
         const VolkDeviceTable& table = m_device->getFunctionTable();
         return table.vkGetBufferDeviceAddress(m_device->getHandle(), &info);
     }
+
+    MemoryRequirements Buffer::getMemoryRequirements(View<Device> device, std::size_t byteNb, BufferUsage usages)
+    {
+        VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+        bufferInfo.size               = byteNb;
+        bufferInfo.sharingMode        = VK_SHARING_MODE_EXCLUSIVE;
+        bufferInfo.usage              = toVulkan(usages | BufferUsage::TransferDst);
+
+        VkBuffer               buffer = VK_NULL_HANDLE;
+        const VolkDeviceTable& table  = device->getFunctionTable();
+        vkCheck(table.vkCreateBuffer(device->getHandle(), &bufferInfo, nullptr, &buffer), "Failed to create buffer!");
+
+        VkMemoryRequirements requirements;
+        table.vkGetBufferMemoryRequirements(device->getHandle(), buffer, &requirements);
+        table.vkDestroyBuffer(device->getHandle(), buffer, nullptr);
+
+        return {requirements.size, requirements.alignment, requirements.memoryTypeBits};
+    }
 } // namespace vzt
@@ -0,0 +1,95 @@
+#include "vzt/vulkan/buffer_pool.hpp"
+
+#include <algorithm>
+
+#include "vzt/core/assert.hpp"
+
+namespace vzt
+{
+    BufferPool::BufferPool(View<Device> device, BufferUsage usages, std::size_t blockByteNb, MemoryLocation location,
+                           bool mappable)
+        : m_device(device), m_usages(usages), m_blockByteNb(blockByteNb), m_location(location), m_mappable(mappable)
+    {
+        VZT_ASSERT(blockByteNb > 0);
+    }
+
+    BufferPool::BufferPool(BufferPool&& other) noexcept
+    {
+        std::swap(m_device, other.m_device);
+        std::swap(m_usages, other.m_usages);
+        std::swap(m_blockByteNb, other.m_blockByteNb);
+        std::swap(m_location, other.m_location);
+        std::swap(m_mappable, other.m_mappable);
+        std::swap(m_blocks, other.m_blocks);
+    }
+
+    BufferPool& BufferPool::operator=(BufferPool&& other) noexcept
+    {
+        std::swap(m_device, other.m_device);
+        std::swap(m_usages, other.m_usages);
+        std::swap(m_blockByteNb, other.m_blockByteNb);
+        std::swap(m_location, other.m_location);
+        std::swap(m_mappable, other.m_mappable);
+        std::swap(m_blocks, other.m_blocks);
+
+        return *this;
+    }
+
+    BufferPool::~BufferPool()
+    {
+        for (Block& block : m_blocks)
+        {
+            // Remaining allocations are released with the pool
+            vmaClearVirtualBlock(block.allocator);
+            vmaDestroyVirtualBlock(block.allocator);
+        }
+    }
+
+    BufferAllocation BufferPool::allocate(std::size_t byteNb, std::size_t alignment)
+    {
+        VZT_ASSERT(byteNb > 0);
+
+        VmaVirtualAllocationCreateInfo info{};
+        info.size      = byteNb;
+        info.alignment = alignment;
+
+        VmaVirtualAllocation allocation = VK_NULL_HANDLE;
+        VkDeviceSize         offset     = 0;
+        for (uint32_t blockId = 0; blockId < m_blocks.size(); blockId++)
+        {
+            Block& block = m_blocks[blockId];
+            if (vmaVirtualAllocate(block.allocator, &info, &allocation, &offset) == VK_SUCCESS)
+                return {{block.buffer, byteNb, offset}, blockId, allocation};
+        }
+
+        const uint32_t blockId = addBlock(std::max(byteNb, m_blockByteNb));
+        Block&         block   = m_blocks[blockId];
+        vkCheck(vmaVirtualAllocate(block.allocator, &info, &allocation, &offset), "Failed to sub-allocate buffer.");
+
+        return {{block.buffer, byteNb, offset}, blockId, allocation};
+    }
+
+    void BufferPool::free(const BufferAllocation& allocation)
+    {
+        VZT_ASSERT(allocation.blockId < m_blocks.size());
+        vmaVirtualFree(m_blocks[allocation.blockId].allocator, allocation.allocation);
+    }
+
+    void BufferPool::clear()
+    {
+        for (Block& block : m_blocks)
+            vmaClearVirtualBlock(block.allocator);
+    }
+
+    uint32_t BufferPool::addBlock(std::size_t byteNb)
+    {
+        Block& block = m_blocks.emplace_back();
+        block.buffer = Buffer(m_device, byteNb, m_usages, m_location, m_mappable);
+
+        VmaVirtualBlockCreateInfo info{};
+        info.size = byteNb;
+        vkCheck(vmaCreateVirtualBlock(&info, &block.allocator), "Failed to create virtual block.");
+
+        return static_cast<uint32_t>(m_blocks.size() - 1);
+    }
+} // namespace vzt
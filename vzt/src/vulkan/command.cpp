@@ -1,7 +1,9 @@
 #include "vzt/vulkan/command.hpp"
 
+#include <algorithm>
 #include <cassert>
 
+#include "vzt/core/logger.hpp"
 #include "vzt/vulkan/acceleration_structure.hpp"
 #include "vzt/vulkan/device.hpp"
 #include "vzt/vulkan/pipeline/compute.hpp"
@@ -10,18 +12,94 @@
 
 namespace vzt
 {
-    CommandBuffer::CommandBuffer(View<Device> device, VkCommandBuffer handle)
-        : DeviceObject<VkCommandBuffer>(device, handle)
+    CommandBuffer::CommandBuffer(View<Device> device, VkCommandBuffer handle, CommandBufferLevel level)
+        : DeviceObject<VkCommandBuffer>(device, handle), m_level(level)
     {
     }
 
     void CommandBuffer::barrier(const PipelineBarrier& barrier)
     {
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        if (m_device->hasSynchronization2())
+        {
+            // Each barrier keeps its own stages instead of sharing the union of the batch
+            const auto getStage = [](PipelineStage stage, PipelineStage fallback) {
+                return static_cast<VkPipelineStageFlags2>(toVulkan(stage == PipelineStage::None ? fallback : stage));
+            };
+
+            std::vector<VkImageMemoryBarrier2> imageBarriers{};
+            imageBarriers.reserve(barrier.imageBarriers.size());
+            for (const auto& baseBarrier : barrier.imageBarriers)
+            {
+                VkImageMemoryBarrier2 imageBarrier{};
+                imageBarrier.sType         = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+                imageBarrier.srcStageMask  = getStage(baseBarrier.srcStage, barrier.src);
+                imageBarrier.srcAccessMask = static_cast<VkAccessFlags2>(toVulkan(baseBarrier.src));
+                imageBarrier.dstStageMask  = getStage(baseBarrier.dstStage, barrier.dst);
+                imageBarrier.dstAccessMask = static_cast<VkAccessFlags2>(toVulkan(baseBarrier.dst));
+                imageBarrier.oldLayout     = toVulkan(baseBarrier.oldLayout);
+                imageBarrier.newLayout     = toVulkan(baseBarrier.newLayout);
+                imageBarrier.srcQueueFamilyIndex =
+                    baseBarrier.srcQueue ? baseBarrier.srcQueue->getId() : VK_QUEUE_FAMILY_IGNORED;
+                imageBarrier.dstQueueFamilyIndex =
+                    baseBarrier.dstQueue ? baseBarrier.dstQueue->getId() : VK_QUEUE_FAMILY_IGNORED;
+                imageBarrier.image = baseBarrier.image->getHandle();
+
+                imageBarrier.subresourceRange.aspectMask     = toVulkan(baseBarrier.aspect);
+                imageBarrier.subresourceRange.baseMipLevel   = baseBarrier.baseLevel;
+                imageBarrier.subresourceRange.levelCount     = baseBarrier.levelCount;
+                imageBarrier.subresourceRange.baseArrayLayer = 0;
+                imageBarrier.subresourceRange.layerCount     = 1;
+
+                imageBarriers.emplace_back(std::move(imageBarrier));
+            }
+
+            std::vector<VkBufferMemoryBarrier2> bufferBarriers{};
+            bufferBarriers.reserve(barrier.bufferBarriers.size());
+            for (const auto& baseBarrier : barrier.bufferBarriers)
+            {
+                VkBufferMemoryBarrier2 bufferBarrier{};
+                bufferBarrier.sType         = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+                bufferBarrier.srcStageMask  = getStage(baseBarrier.srcStage, barrier.src);
+                bufferBarrier.srcAccessMask = static_cast<VkAccessFlags2>(toVulkan(baseBarrier.src));
+                bufferBarrier.dstStageMask  = getStage(baseBarrier.dstStage, barrier.dst);
+                bufferBarrier.dstAccessMask = static_cast<VkAccessFlags2>(toVulkan(baseBarrier.dst));
+                bufferBarrier.srcQueueFamilyIndex =
+                    baseBarrier.srcQueue ? baseBarrier.srcQueue->getId() : VK_QUEUE_FAMILY_IGNORED;
+                bufferBarrier.dstQueueFamilyIndex =
+                    baseBarrier.dstQueue ? baseBarrier.dstQueue->getId() : VK_QUEUE_FAMILY_IGNORED;
+
+                bufferBarrier.buffer = baseBarrier.buffer.buffer->getHandle();
+                bufferBarrier.size   = baseBarrier.buffer.size;
+                bufferBarrier.offset = baseBarrier.buffer.offset;
+
+                bufferBarriers.emplace_back(std::move(bufferBarrier));
+            }
+
+            VkDependencyInfo dependencyInfo{};
+            dependencyInfo.sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+            dependencyInfo.dependencyFlags          = toVulkan(barrier.dependency);
+            dependencyInfo.bufferMemoryBarrierCount = static_cast<uint32_t>(bufferBarriers.size());
+            dependencyInfo.pBufferMemoryBarriers    = bufferBarriers.data();
+            dependencyInfo.imageMemoryBarrierCount  = static_cast<uint32_t>(imageBarriers.size());
+            dependencyInfo.pImageMemoryBarriers     = imageBarriers.data();
+
+            table.vkCmdPipelineBarrier2KHR(m_handle, &dependencyInfo);
+            return;
+        }
+
+        // Legacy barriers share a single stage pair: the union of all barriers' stages
+        PipelineStage src = barrier.src;
+        PipelineStage dst = barrier.dst;
+
         std::vector<VkImageMemoryBarrier> imageBarriers{};
         imageBarriers.reserve(barrier.imageBarriers.size());
 
         for (const auto& baseBarrier : barrier.imageBarriers)
         {
+            src |= baseBarrier.srcStage;
+            dst |= baseBarrier.dstStage;
+
             VkImageMemoryBarrier imageBarrier{};
             imageBarrier.sType         = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
             imageBarrier.srcAccessMask = toVulkan(baseBarrier.src);
@@ -47,6 +125,9 @@ namespace vzt
         bufferBarriers.reserve(barrier.bufferBarriers.size());
         for (const auto& baseBarrier : barrier.bufferBarriers)
         {
+            src |= baseBarrier.srcStage;
+            dst |= baseBarrier.dstStage;
+
             VkBufferMemoryBarrier bufferBarrier{};
             bufferBarrier.sType         = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
             bufferBarrier.srcAccessMask = toVulkan(baseBarrier.src);
@@ -63,9 +144,14 @@ namespace vzt
             bufferBarriers.emplace_back(std::move(bufferBarrier));
         }
 
-        const VolkDeviceTable& table = m_device->getFunctionTable();
-        table.vkCmdPipelineBarrier(m_handle, toVulkan(barrier.src), toVulkan(barrier.dst), toVulkan(barrier.dependency),
-                                   0, nullptr, static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(),
+        // Stage masks cannot be empty without Synchronization2
+        if (src == PipelineStage::None)
+            src = PipelineStage::TopOfPipe;
+        if (dst == PipelineStage::None)
+            dst = PipelineStage::BottomOfPipe;
+
+        table.vkCmdPipelineBarrier(m_handle, toVulkan(src), toVulkan(dst), toVulkan(barrier.dependency), 0, nullptr,
+                                   static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(),
                                    static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
     }
 
@@ -198,6 +284,87 @@ namespace vzt
              dst, dstLayout, ImageAspect::Color, Vec2u{0}, Vec2u{srcExtent.width, srcExtent.height}, filter);
     }
 
+    void CommandBuffer::generateMipmaps(View<DeviceImage> image, ImageLayout finalLayout)
+    {
+        const Extent3D size    = image->getSize();
+        const uint32_t levelNb = image->getMipLevels();
+
+        const PhysicalDevice hardware = m_device->getHardware();
+        const FormatFeature  features = hardware.getFormatFeatures(image->getFormat(), image->getTiling());
+        if (!any(features & FormatFeature::BlitSrc) || !any(features & FormatFeature::BlitDst))
+        {
+            logger::warn("[CommandBuffer] Format of the image does not support blits, mipmaps are not generated.");
+
+            ImageBarrier transition{};
+            transition.image      = image;
+            transition.oldLayout  = ImageLayout::TransferDstOptimal;
+            transition.newLayout  = finalLayout;
+            transition.src        = Access::TransferWrite;
+            transition.dst        = Access::ShaderRead;
+            transition.levelCount = levelNb;
+            barrier(PipelineStage::Transfer, PipelineStage::AllCommands, transition);
+            return;
+        }
+
+        const bool   linear = any(features & FormatFeature::SampledImageFilterLinear);
+        const Filter filter = linear ? Filter::Linear : Filter::Nearest;
+
+        uint32_t width  = size.width;
+        uint32_t height = size.height;
+        uint32_t depth  = size.depth;
+        for (uint32_t level = 1; level < levelNb; level++)
+        {
+            // The previous level becomes the source of the next one
+            ImageBarrier source{};
+            source.image     = image;
+            source.oldLayout = ImageLayout::TransferDstOptimal;
+            source.newLayout = ImageLayout::TransferSrcOptimal;
+            source.src       = Access::TransferWrite;
+            source.dst       = Access::TransferRead;
+            source.baseLevel = level - 1;
+            barrier(PipelineStage::Transfer, PipelineStage::Transfer, source);
+
+            const uint32_t nextWidth  = std::max(width / 2u, 1u);
+            const uint32_t nextHeight = std::max(height / 2u, 1u);
+            const uint32_t nextDepth  = std::max(depth / 2u, 1u);
+
+            Blit region{};
+            region.srcOffsets[0] = Extent3D{0, 0, 0};
+            region.srcOffsets[1] = Extent3D{width, height, depth};
+            region.srcAspect     = ImageAspect::Color;
+            region.srcMipLevel   = level - 1;
+            region.dstOffsets[0] = Extent3D{0, 0, 0};
+            region.dstOffsets[1] = Extent3D{nextWidth, nextHeight, nextDepth};
+            region.dstAspect     = ImageAspect::Color;
+            region.dstMipLevel   = level;
+            blit(image, ImageLayout::TransferSrcOptimal, image, ImageLayout::TransferDstOptimal, filter, region);
+
+            width  = nextWidth;
+            height = nextHeight;
+            depth  = nextDepth;
+        }
+
+        // All levels but the last one were used as blit sources
+        ImageBarrier transition{};
+        transition.image = image;
+        transition.dst   = Access::ShaderRead;
+        if (levelNb > 1)
+        {
+            transition.oldLayout  = ImageLayout::TransferSrcOptimal;
+            transition.newLayout  = finalLayout;
+            transition.src        = Access::TransferRead;
+            transition.levelCount = levelNb - 1;
+            barrier(PipelineStage::Transfer, PipelineStage::AllCommands, transition);
+        }
+
+        transition.oldLayout  = ImageLayout::TransferDstOptimal;
+        transition.newLayout  = finalLayout;
+        transition.src        = Access::TransferWrite;
+        transition.baseLevel  = levelNb - 1;
+        transition.levelCount = 1;
+        barrier(PipelineStage::Transfer, PipelineStage::AllCommands, transition);
+    }
+
     void CommandBuffer::copy(View<Buffer> src, View<Buffer> dst, uint64_t size, uint64_t srcOffset, uint64_t dstOffset)
     {
         VkBufferCopy copyRegion;
@@ -210,9 +377,10 @@ namespace vzt
     }
 
     void CommandBuffer::copy(View<Buffer> src, View<DeviceImage> dst, uint32_t width, uint32_t height,
-                             ImageAspect aspect)
+                             ImageAspect aspect, uint64_t srcOffset)
     {
         VkBufferImageCopy region           = {};
+        region.bufferOffset                = srcOffset;
         region.imageSubresource.aspectMask = vzt::toVulkan(aspect);
         region.imageSubresource.layerCount = 1;
         region.imageExtent.width           = width;
@@ -247,14 +415,16 @@ namespace vzt
         table.vkCmdBindPipeline(m_handle, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicPipeline.getHandle());
     }
 
-    void CommandBuffer::bind(const GraphicsPipeline& graphicPipeline, const DescriptorSet& set)
+    void CommandBuffer::bind(const GraphicsPipeline& graphicPipeline, const DescriptorSet& set,
+                             CSpan<uint32_t> dynamicOffsets)
     {
         bind(graphicPipeline);
         const VkDescriptorSet descriptorSet = set.getHandle();
 
         const VolkDeviceTable& table = m_device->getFunctionTable();
         table.vkCmdBindDescriptorSets(m_handle, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicPipeline.getLayout(), 0, 1,
-                                      &descriptorSet, 0, nullptr);
+                                      &descriptorSet, static_cast<uint32_t>(dynamicOffsets.size),
+                                      dynamicOffsets.data);
     }
 
     void CommandBuffer::bind(const ComputePipeline& computePipeline)
@@ -263,14 +433,16 @@ namespace vzt
         table.vkCmdBindPipeline(m_handle, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline.getHandle());
     }
 
-    void CommandBuffer::bind(const ComputePipeline& computePipeline, const DescriptorSet& set)
+    void CommandBuffer::bind(const ComputePipeline& computePipeline, const DescriptorSet& set,
+                             CSpan<uint32_t> dynamicOffsets)
     {
         bind(computePipeline);
         const VkDescriptorSet descriptorSet = set.getHandle();
 
         const VolkDeviceTable& table = m_device->getFunctionTable();
         table.vkCmdBindDescriptorSets(m_handle, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline.getLayout(), 0, 1,
-                                      &descriptorSet, 0, nullptr);
+                                      &descriptorSet, static_cast<uint32_t>(dynamicOffsets.size),
+                                      dynamicOffsets.data);
     }
 
     void CommandBuffer::bind(const RaytracingPipeline& raytracingPipeline)
@@ -279,20 +451,22 @@ namespace vzt
         table.vkCmdBindPipeline(m_handle, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, raytracingPipeline.getHandle());
     }
 
-    void CommandBuffer::bind(const RaytracingPipeline& raytracingPipeline, const DescriptorSet& set)
+    void CommandBuffer::bind(const RaytracingPipeline& raytracingPipeline, const DescriptorSet& set,
+                             CSpan<uint32_t> dynamicOffsets)
     {
         bind(raytracingPipeline);
 
         const VkDescriptorSet  descriptorSet = set.getHandle();
         const VolkDeviceTable& table         = m_device->getFunctionTable();
         table.vkCmdBindDescriptorSets(m_handle, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, raytracingPipeline.getLayout(),
-                                      0, 1, &descriptorSet, 0, nullptr);
+                                      0, 1, &descriptorSet, static_cast<uint32_t>(dynamicOffsets.size),
+                                      dynamicOffsets.data);
     }
 
-    void CommandBuffer::bindVertexBuffer(const Buffer& buffer)
+    void CommandBuffer::bindVertexBuffer(const BufferCSpan& buffer)
     {
-        VkBuffer     vertexBuffers[] = {buffer.getHandle()};
-        VkDeviceSize offsets[]       = {0};
+        VkBuffer     vertexBuffers[] = {buffer.buffer->getHandle()};
+        VkDeviceSize offsets[]       = {buffer.offset};
 
         const VolkDeviceTable& table = m_device->getFunctionTable();
         table.vkCmdBindVertexBuffers(m_handle, 0, 1, vertexBuffers, offsets);
@@ -305,10 +479,11 @@ namespace vzt
         table.vkCmdPushConstants(m_handle, pipeline.getLayout(), toVulkan(stages), offset, size, data);
     }
 
-    void CommandBuffer::bindIndexBuffer(const Buffer& buffer, std::size_t index)
+    void CommandBuffer::bindIndexBuffer(const BufferCSpan& buffer, std::size_t index)
     {
-        const VolkDeviceTable& table = m_device->getFunctionTable();
-        table.vkCmdBindIndexBuffer(m_handle, buffer.getHandle(), index * sizeof(uint32_t), VK_INDEX_TYPE_UINT32);
+        const VkDeviceSize     offset = buffer.offset + index * sizeof(uint32_t);
+        const VolkDeviceTable& table  = m_device->getFunctionTable();
+        table.vkCmdBindIndexBuffer(m_handle, buffer.buffer->getHandle(), offset, VK_INDEX_TYPE_UINT32);
     }
 
     void CommandBuffer::dispatch(uint32_t x, uint32_t y, uint32_t z)
@@ -324,7 +499,7 @@ namespace vzt
         table.vkCmdDraw(m_handle, vertexCount, instanceCount, vertexOffset, instanceOffset);
     }
 
-    void CommandBuffer::drawIndexed(const Buffer& indexBuffer, const Range<>& range, uint32_t instanceCount,
+    void CommandBuffer::drawIndexed(const BufferCSpan& indexBuffer, const Range<>& range, uint32_t instanceCount,
                                     int32_t vertexOffset, uint32_t instanceOffset)
     {
         bindIndexBuffer(indexBuffer, range.start);
@@ -472,6 +647,20 @@ namespace vzt
         table.vkCmdEndRenderingKHR(m_handle);
     }
 
+    void CommandBuffer::execute(CSpan<CommandBuffer> secondaries)
+    {
+        std::vector<VkCommandBuffer> handles{};
+        handles.reserve(secondaries.size);
+        for (const CommandBuffer& secondary : secondaries)
+        {
+            assert(secondary.m_level == CommandBufferLevel::Secondary && "Only secondary command buffers are executed");
+            handles.emplace_back(secondary.getHandle());
+        }
+
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        table.vkCmdExecuteCommands(m_handle, static_cast<uint32_t>(handles.size()), handles.data());
+    }
+
     void CommandBuffer::buildAs(AccelerationStructureBuilder& builder)
     {
         VkAccelerationStructureBuildGeometryInfoKHR accelerationBuildGeometryInfo{};
@@ -531,6 +720,12 @@ namespace vzt
         VkCommandBufferBeginInfo beginInfo{};
         beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
+        // Secondary command buffers do not inherit any render pass, rendering is started by their own commands
+        VkCommandBufferInheritanceInfo inheritanceInfo{};
+        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        if (m_level == CommandBufferLevel::Secondary)
+            beginInfo.pInheritanceInfo = &inheritanceInfo;
+
         const VolkDeviceTable& table = m_device->getFunctionTable();
         vkCheck(table.vkBeginCommandBuffer(m_handle, &beginInfo),
                 "Failed to start the recording of the command buffer");
@@ -542,8 +737,8 @@ namespace vzt
         vkCheck(table.vkEndCommandBuffer(m_handle), "Failed to end command buffer recording");
     }
 
-    CommandPool::CommandPool(View<Device> device, View<Queue> queue, uint32_t bufferNb)
-        : DeviceObject<VkCommandPool>(device)
+    CommandPool::CommandPool(View<Device> device, View<Queue> queue, uint32_t bufferNb, CommandBufferLevel level)
+        : DeviceObject<VkCommandPool>(device), m_queue(queue), m_level(level)
     {
         VkCommandPoolCreateInfo commandPoolInfo{};
         commandPoolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
@@ -561,12 +756,14 @@ namespace vzt
     {
         std::swap(m_commandBuffers, other.m_commandBuffers);
         std::swap(m_queue, other.m_queue);
+        std::swap(m_level, other.m_level);
     }
 
     CommandPool& CommandPool::operator=(CommandPool&& other) noexcept
     {
         std::swap(m_commandBuffers, other.m_commandBuffers);
         std::swap(m_queue, other.m_queue);
+        std::swap(m_level, other.m_level);
 
         DeviceObject<VkCommandPool>::operator=(std::move(other));
         return *this;
@@ -603,7 +800,7 @@ namespace vzt
         VkCommandBufferAllocateInfo commandBufferAllocInfo{};
         commandBufferAllocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
         commandBufferAllocInfo.commandPool        = m_handle;
-        commandBufferAllocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        commandBufferAllocInfo.level              = toVulkan(m_level);
         commandBufferAllocInfo.commandBufferCount = count;
 
         const VolkDeviceTable& table = m_device->getFunctionTable();
@@ -614,6 +811,6 @@ namespace vzt
     CommandBuffer CommandPool::operator[](uint32_t bufferNumber)
     {
         assert(bufferNumber < m_commandBuffers.size() && "bufferNumber should be < than m_commandBuffers.size()");
-        return CommandBuffer(m_device, m_commandBuffers[bufferNumber]);
+        return CommandBuffer(m_device, m_commandBuffers[bufferNumber], m_level);
     }
 } // namespace vzt
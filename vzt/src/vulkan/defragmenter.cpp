@@ -0,0 +1,186 @@
+#include "vzt/vulkan/defragmenter.hpp"
+
+#include "vzt/core/assert.hpp"
+#include "vzt/core/logger.hpp"
+
+namespace vzt
+{
+    Defragmenter::Defragmenter(View<Device> device, uint32_t frameNb, uint64_t maxBytesPerPass,
+                               uint32_t maxMovesPerPass)
+        : m_device(device), m_queue(device->getQueue(QueueType::Transfer)), m_frameNb(frameNb),
+          m_maxBytesPerPass(maxBytesPerPass), m_maxMovesPerPass(maxMovesPerPass), m_pool(device, m_queue, 1),
+          m_timeline(device, SemaphoreType::Timeline)
+    {
+    }
+
+    Defragmenter::~Defragmenter()
+    {
+        if (m_state == State::Idle)
+            return;
+
+        if (m_state == State::Copying)
+        {
+            m_timeline.wait(m_value);
+            patch();
+        }
+
+        if (m_state == State::Retiring)
+        {
+            m_device->wait();
+            endPass();
+        }
+
+        if (m_state != State::Idle)
+            finish();
+    }
+
+    void Defragmenter::start()
+    {
+        if (m_state != State::Idle)
+            return;
+
+        VmaDefragmentationInfo info{};
+        info.maxBytesPerPass       = m_maxBytesPerPass;
+        info.maxAllocationsPerPass = m_maxMovesPerPass;
+        vkCheck(vmaBeginDefragmentation(m_device->getAllocator(), &info, &m_context),
+                "Failed to begin defragmentation.");
+
+        m_state       = State::Ready;
+        m_movedByteNb = 0;
+    }
+
+    bool Defragmenter::update()
+    {
+        if (m_state == State::Ready)
+        {
+            beginPass();
+        }
+        else if (m_state == State::Copying)
+        {
+            if (m_timeline.getValue() >= m_value)
+                patch();
+        }
+        else if (m_state == State::Retiring)
+        {
+            if (m_retiringFrames > 0)
+                m_retiringFrames--;
+            else
+                endPass();
+        }
+
+        return m_state != State::Idle;
+    }
+
+    void Defragmenter::beginPass()
+    {
+        const VmaAllocator allocator = m_device->getAllocator();
+        if (vmaBeginDefragmentationPass(allocator, m_context, &m_pass) == VK_SUCCESS)
+        {
+            // Nothing left to move
+            finish();
+            return;
+        }
+
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+
+        CommandBuffer commands = m_pool[0];
+        commands.begin();
+
+        m_moves.clear();
+        for (uint32_t i = 0; i < m_pass.moveCount; i++)
+        {
+            VmaDefragmentationMove& move = m_pass.pMoves[i];
+
+            VmaAllocationInfo allocationInfo{};
+            vmaGetAllocationInfo(allocator, move.srcAllocation, &allocationInfo);
+
+            // Only movable buffers reference their owner
+            const auto* buffer = static_cast<const Buffer*>(allocationInfo.pUserData);
+            if (!buffer)
+            {
+                move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                continue;
+            }
+
+            VkBufferCreateInfo bufferInfo{};
+            bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            bufferInfo.size        = buffer->size();
+            bufferInfo.usage       = toVulkan(buffer->getUsages() | BufferUsage::TransferDst);
+            bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+            VkBuffer handle = VK_NULL_HANDLE;
+            vkCheck(table.vkCreateBuffer(m_device->getHandle(), &bufferInfo, nullptr, &handle),
+                    "Failed to create buffer.");
+            vkCheck(vmaBindBufferMemory(allocator, move.dstTmpAllocation, handle), "Failed to bind buffer memory.");
+
+            VkBufferCopy region{};
+            region.size = buffer->size();
+            table.vkCmdCopyBuffer(commands.getHandle(), buffer->getHandle(), handle, 1, &region);
+
+            m_moves.emplace_back(Move{move.srcAllocation, handle, buffer->size()});
+        }
+
+        commands.end();
+
+        // The copy runs on the transfer queue without synchronization with other queues: writes to the moved buffers
+        // by frames still in flight would land in their previous allocation and be lost once patched.
+        if (!m_moves.empty())
+            m_device->wait();
+
+        m_queue->submit(commands, m_timeline, ++m_value);
+
+        m_state = State::Copying;
+    }
+
+    void Defragmenter::patch()
+    {
+        const VmaAllocator allocator = m_device->getAllocator();
+        for (Move& move : m_moves)
+        {
+            // The owner is found again as the buffer may have been moved since the beginning of the pass
+            VmaAllocationInfo allocationInfo{};
+            vmaGetAllocationInfo(allocator, move.allocation, &allocationInfo);
+
+            auto* buffer = static_cast<Buffer*>(allocationInfo.pUserData);
+            VZT_ASSERT(buffer && "Movable buffers must outlive defragmentation passes");
+
+            std::swap(buffer->m_handle, move.handle);
+            m_movedByteNb += move.size;
+
+            if (m_callback)
+                m_callback(*buffer);
+        }
+
+        m_state          = State::Retiring;
+        m_retiringFrames = m_frameNb;
+    }
+
+    void Defragmenter::endPass()
+    {
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        for (const Move& move : m_moves)
+            table.vkDestroyBuffer(m_device->getHandle(), move.handle, nullptr);
+        m_moves.clear();
+
+        // Moved allocations now refer to their new place, previous ones are freed
+        if (vmaEndDefragmentationPass(m_device->getAllocator(), m_context, &m_pass) == VK_SUCCESS)
+            finish();
+        else
+            m_state = State::Ready;
+    }
+
+    void Defragmenter::finish()
+    {
+        VmaDefragmentationStats stats{};
+        vmaEndDefragmentation(m_device->getAllocator(), m_context, &stats);
+
+        constexpr double MB = 1024. * 1024.;
+        logger::info("[Defragmenter] {} allocations moved ({:.2f}MB), {:.2f}MB and {} blocks freed.",
+                     stats.allocationsMoved, static_cast<double>(stats.bytesMoved) / MB,
+                     static_cast<double>(stats.bytesFreed) / MB, stats.deviceMemoryBlocksFreed);
+
+        m_context = VK_NULL_HANDLE;
+        m_pass    = {};
+        m_state   = State::Idle;
+    }
+} // namespace vzt
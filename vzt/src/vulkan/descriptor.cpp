@@ -222,6 +222,13 @@ namespace vzt
                                       info.buffer = buffer.buffer.buffer->getHandle();
                                       info.offset = buffer.buffer.offset;
                                       info.range  = buffer.buffer.buffer->size() - buffer.buffer.offset;
+
+                                      // Dynamic offsets are added to the descriptor's offset, its range is bounded
+                                      const bool dynamic = buffer.type == DescriptorType::UniformBufferDynamic ||
+                                                           buffer.type == DescriptorType::StorageBufferDynamic;
+                                      if (dynamic)
+                                          info.range = buffer.buffer.size;
+
                                       descriptorBufferInfo.emplace_back(info);
 
                                       VkWriteDescriptorSet descriptorWrite{};
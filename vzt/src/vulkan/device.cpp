@@ -1,5 +1,7 @@
 #include "vzt/vulkan/device.hpp"
 
+#include <algorithm>
+#include <string_view>
 #include <unordered_map>
 
 #define VMA_IMPLEMENTATION
@@ -10,10 +12,16 @@
 
 #include <volk.h>
 
+#include "vzt/core/assert.hpp"
+#include "vzt/core/logger.hpp"
 #include "vzt/vulkan/command.hpp"
+#include "vzt/vulkan/fence.hpp"
 #include "vzt/vulkan/instance.hpp"
+#include "vzt/vulkan/pipeline/cache.hpp"
+#include "vzt/vulkan/semaphore.hpp"
 #include "vzt/vulkan/surface.hpp"
 #include "vzt/vulkan/swapchain.hpp"
+#include "vzt/vulkan/upload.hpp"
 
 namespace vzt
 {
@@ -38,6 +46,7 @@ namespace vzt
         VkPhysicalDeviceVulkan12Features features12{};
         features12.sType               = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
         features12.bufferDeviceAddress = VK_TRUE;
+        features12.timelineSemaphore   = VK_TRUE;
         features.add(features12);
 
         // dynamicRendering.
@@ -58,6 +67,7 @@ namespace vzt
         VkPhysicalDeviceVulkan12Features features12{};
         features12.sType               = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
         features12.bufferDeviceAddress = VK_TRUE;
+        features12.timelineSemaphore   = VK_TRUE;
         features12.descriptorIndexing  = VK_TRUE;
         features.add(features12);
 
@@ -285,6 +295,32 @@ namespace vzt
         throw std::runtime_error("Failed to find supported format!");
     }
 
+    FormatFeature PhysicalDevice::getFormatFeatures(Format format, ImageTiling tiling) const
+    {
+        VkFormatProperties props;
+        vkGetPhysicalDeviceFormatProperties(m_handle, toVulkan(format), &props);
+
+        const VkFormatFeatureFlags features =
+            tiling == ImageTiling::Linear ? props.linearTilingFeatures : props.optimalTilingFeatures;
+        return static_cast<FormatFeature>(features);
+    }
+
+    bool PhysicalDevice::supportsSynchronization2() const
+    {
+        if (!hasExtensions({dext::Synchronization2}))
+            return false;
+
+        VkPhysicalDeviceSynchronization2FeaturesKHR synchronization2{};
+        synchronization2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR;
+
+        VkPhysicalDeviceFeatures2 features{};
+        features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features.pNext = &synchronization2;
+        vkGetPhysicalDeviceFeatures2(m_handle, &features);
+
+        return synchronization2.synchronization2 == VK_TRUE;
+    }
+
     std::size_t PhysicalDevice::getUniformAlignment(std::size_t alignment) const
     {
         const std::size_t minUboAlignment = m_properties.limits.minUniformBufferOffsetAlignment;
@@ -293,6 +329,8 @@ namespace vzt
         return alignment;
     }
 
+    Device::Device() = default;
+
     Device::Device(View<Instance> instance, PhysicalDevice device, DeviceBuilder configuration, View<Surface> surface)
         : m_instance(instance), m_device(device), m_configuration(configuration)
     {
@@ -345,6 +383,108 @@ namespace vzt
             queueCreateInfos.push_back(queueCreateInfo);
         }
 
+        // Dedicated compute queue allowing compute work to overlap with graphics work
+        if (configuration.hasAsyncCompute())
+        {
+            bool found = false;
+            for (uint32_t i = 0; !found && i < queuesFamilies.size(); i++)
+            {
+                const VkQueueFlags flags = queuesFamilies[i].queueFlags;
+                if (!(flags & VK_QUEUE_COMPUTE_BIT) || (flags & VK_QUEUE_GRAPHICS_BIT))
+                    continue;
+
+                const bool used = std::any_of(queueIds.begin(), queueIds.end(),
+                                              [i](const auto& queueId) { return queueId.second == i; });
+                if (used)
+                    continue;
+
+                queueIds[QueueType::Compute] = i;
+                found                        = true;
+
+                VkDeviceQueueCreateInfo queueCreateInfo{};
+                queueCreateInfo.sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+                queueCreateInfo.queueFamilyIndex = i;
+                queueCreateInfo.queueCount       = 1;
+                queueCreateInfo.pQueuePriorities = &queuePriority;
+                queueCreateInfos.push_back(queueCreateInfo);
+            }
+
+            if (!found)
+                logger::warn("[Device] No dedicated compute queue family, compute work shares the graphics queue.");
+        }
+
+        // Synchronization2 allows per-barrier stage masks and is enabled when supported, unless the user configured it
+        m_synchronization2 = m_device.supportsSynchronization2();
+        if (m_synchronization2)
+        {
+            const auto& extensions = configuration.getExtensions();
+            const bool  hasExtension = std::any_of(extensions.begin(), extensions.end(), [](dext::Extension extension) {
+                return std::string_view(extension) == dext::Synchronization2;
+            });
+            if (!hasExtension)
+                configuration.add(dext::Synchronization2);
+
+            bool configured = false;
+            for (const GenericDeviceFeature& feature : configuration.getDeviceFeatures().getFeatures())
+            {
+                if (feature.sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR)
+                {
+                    using Features       = VkPhysicalDeviceSynchronization2FeaturesKHR;
+                    const auto* features = reinterpret_cast<const Features*>(&feature);
+                    m_synchronization2   = features->synchronization2 == VK_TRUE;
+                    configured           = true;
+                }
+                else if (feature.sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES)
+                {
+                    const auto* features = reinterpret_cast<const VkPhysicalDeviceVulkan13Features*>(&feature);
+                    m_synchronization2   = features->synchronization2 == VK_TRUE;
+                    configured           = true;
+                }
+            }
+
+            if (!configured)
+            {
+                VkPhysicalDeviceSynchronization2FeaturesKHR synchronization2{};
+                synchronization2.sType            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR;
+                synchronization2.synchronization2 = VK_TRUE;
+                configuration.getDeviceFeatures().add(synchronization2);
+            }
+        }
+
+        // Timeline semaphores track uploads and other asynchronous work. Their support is mandatory since Vulkan 1.2,
+        // so they are enabled on top of the user configuration.
+        const uint32_t apiVersion = std::min(static_cast<uint32_t>(instance->getAPIVersion()),
+                                             m_device.getProperties().apiVersion);
+        m_timelineSemaphore       = apiVersion >= VK_API_VERSION_1_2;
+        if (m_timelineSemaphore)
+        {
+            bool configured = false;
+            for (GenericDeviceFeature& feature : configuration.getDeviceFeatures().getFeatures())
+            {
+                if (feature.sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES)
+                {
+                    using Features              = VkPhysicalDeviceTimelineSemaphoreFeatures;
+                    auto* features              = reinterpret_cast<Features*>(&feature);
+                    features->timelineSemaphore = VK_TRUE;
+                    configured                  = true;
+                }
+                else if (feature.sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES)
+                {
+                    auto* features              = reinterpret_cast<VkPhysicalDeviceVulkan12Features*>(&feature);
+                    features->timelineSemaphore = VK_TRUE;
+                    configured                  = true;
+                }
+            }
+
+            if (!configured)
+            {
+                VkPhysicalDeviceTimelineSemaphoreFeatures timelineSemaphore{};
+                timelineSemaphore.sType             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+                timelineSemaphore.timelineSemaphore = VK_TRUE;
+                configuration.getDeviceFeatures().add(timelineSemaphore);
+            }
+        }
+
         VkDeviceCreateInfo createInfo{};
         createInfo.sType                = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
         createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
@@ -397,10 +537,25 @@ namespace vzt
         allocatorInfo.pVulkanFunctions           = &vmaVulkanFunctions;
 
         vkCheck(vmaCreateAllocator(&allocatorInfo, &m_allocator), "Failed to create allocator.");
+
+        const Path& pipelineCachePath = m_configuration.getPipelineCachePath();
+        if (pipelineCachePath.empty())
+            m_pipelineCache = std::make_unique<PipelineCache>(this);
+        else
+            m_pipelineCache = std::make_unique<PipelineCache>(PipelineCache::From(this, pipelineCachePath));
     }
 
     Device::Device(Device&& other) noexcept
     {
+        // The upload manager refers to the device address, it is recreated on first use
+        other.m_uploadManager.reset();
+
+        // As does the pipeline cache, which is recreated from its current content
+        std::vector<uint8_t> pipelineCacheData;
+        if (other.m_pipelineCache)
+            pipelineCacheData = other.m_pipelineCache->getData();
+        other.m_pipelineCache.reset();
+
         std::swap(m_instance, other.m_instance);
         std::swap(m_device, other.m_device);
         std::swap(m_table, other.m_table);
@@ -408,13 +563,30 @@ namespace vzt
         std::swap(m_handle, other.m_handle);
         std::swap(m_allocator, other.m_allocator);
         std::swap(m_configuration, other.m_configuration);
+        std::swap(m_synchronization2, other.m_synchronization2);
+        std::swap(m_timelineSemaphore, other.m_timelineSemaphore);
 
         for (auto& queue : other.m_queues)
             m_queues.emplace(this, queue.getType(), queue.getId(), queue.canPresent());
+
+        if (m_handle != VK_NULL_HANDLE)
+            m_pipelineCache = std::make_unique<PipelineCache>(this, pipelineCacheData);
     }
 
     Device& Device::operator=(Device&& other) noexcept
     {
+        m_uploadManager.reset();
+        other.m_uploadManager.reset();
+
+        std::vector<uint8_t> pipelineCacheData;
+        std::vector<uint8_t> otherPipelineCacheData;
+        if (m_pipelineCache)
+            otherPipelineCacheData = m_pipelineCache->getData();
+        if (other.m_pipelineCache)
+            pipelineCacheData = other.m_pipelineCache->getData();
+        m_pipelineCache.reset();
+        other.m_pipelineCache.reset();
+
         std::swap(m_instance, other.m_instance);
         std::swap(m_device, other.m_device);
         std::swap(m_table, other.m_table);
@@ -422,9 +594,17 @@ namespace vzt
         std::swap(m_handle, other.m_handle);
         std::swap(m_allocator, other.m_allocator);
         std::swap(m_configuration, other.m_configuration);
+        std::swap(m_synchronization2, other.m_synchronization2);
+        std::swap(m_timelineSemaphore, other.m_timelineSemaphore);
 
         for (auto& queue : other.m_queues)
             m_queues.emplace(this, queue.getType(), queue.getId(), queue.canPresent());
+
+        if (m_handle != VK_NULL_HANDLE)
+            m_pipelineCache = std::make_unique<PipelineCache>(this, pipelineCacheData);
+        if (other.m_handle != VK_NULL_HANDLE)
+            other.m_pipelineCache = std::make_unique<PipelineCache>(&other, otherPipelineCacheData);
+
         return *this;
         ;
     }
@@ -434,14 +614,88 @@ namespace vzt
         if (m_handle == VK_NULL_HANDLE)
             return;
 
+        m_uploadManager.reset();
         wait();
 
+        savePipelineCache();
+        m_pipelineCache.reset();
+
         vmaDestroyAllocator(m_allocator);
         m_table.vkDestroyDevice(m_handle, nullptr);
     }
 
     void Device::wait() const { m_table.vkDeviceWaitIdle(m_handle); }
 
+    UploadManager& Device::getUploadManager() const
+    {
+        VZT_ASSERT(m_timelineSemaphore && "Uploads require timeline semaphores, available since Vulkan 1.2.");
+
+        std::lock_guard lock{m_uploadMutex};
+        if (!m_uploadManager)
+            m_uploadManager = std::make_unique<UploadManager>(this);
+
+        return *m_uploadManager;
+    }
+
+    MemoryStatistics Device::getMemoryStatistics() const
+    {
+        const VkPhysicalDeviceMemoryProperties* properties = nullptr;
+        vmaGetMemoryProperties(m_allocator, &properties);
+
+        std::vector<VmaBudget> budgets(properties->memoryHeapCount);
+        vmaGetHeapBudgets(m_allocator, budgets.data());
+
+        VmaTotalStatistics total{};
+        vmaCalculateStatistics(m_allocator, &total);
+
+        MemoryStatistics statistics{};
+        statistics.blockBytes      = total.total.statistics.blockBytes;
+        statistics.allocationBytes = total.total.statistics.allocationBytes;
+        statistics.blockNb         = total.total.statistics.blockCount;
+        statistics.allocationNb    = total.total.statistics.allocationCount;
+
+        statistics.heaps.resize(properties->memoryHeapCount);
+        for (uint32_t i = 0; i < properties->memoryHeapCount; i++)
+        {
+            const VmaDetailedStatistics& detailed = total.memoryHeap[i];
+
+            MemoryHeapStatistics& heap = statistics.heaps[i];
+            heap.budget                = budgets[i].budget;
+            heap.usage                 = budgets[i].usage;
+            heap.blockBytes            = detailed.statistics.blockBytes;
+            heap.allocationBytes       = detailed.statistics.allocationBytes;
+            heap.blockNb               = detailed.statistics.blockCount;
+            heap.allocationNb          = detailed.statistics.allocationCount;
+            heap.deviceLocal           = properties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+
+            const uint64_t unused = heap.blockBytes - heap.allocationBytes;
+            if (unused > 0 && detailed.unusedRangeCount > 0)
+                heap.fragmentation = 1.f - static_cast<float>(detailed.unusedRangeSizeMax) / static_cast<float>(unused);
+        }
+
+        return statistics;
+    }
+
+    bool Device::savePipelineCache() const
+    {
+        const Path& path = m_configuration.getPipelineCachePath();
+        if (path.empty() || !m_pipelineCache)
+            return false;
+
+        return m_pipelineCache->save(path);
+    }
+
+    std::string Device::getMemoryDump(bool detailed) const
+    {
+        char* json = nullptr;
+        vmaBuildStatsString(m_allocator, &json, detailed ? VK_TRUE : VK_FALSE);
+
+        std::string dump = json;
+        vmaFreeStatsString(m_allocator, json);
+
+        return dump;
+    }
+
     std::vector<View<Queue>> Device::getQueues() const
     {
         std::vector<View<Queue>> queues{};
@@ -497,22 +751,45 @@ namespace vzt
         submit(commands);
     }
 
-    void Queue::submit(const CommandBuffer& commandBuffer, const SwapchainSubmission& submission) const
+    void Queue::submit(const CommandBuffer& commandBuffer, const SwapchainSubmission& submission,
+                       CSpan<SemaphoreWait> waits) const
     {
         assert(m_canPresent && "This queue is unable to present and is used for a swapchain submission");
 
         const VkCommandBuffer commands = commandBuffer.getHandle();
 
+        std::vector<VkSemaphore>          waitSemaphores{submission.imageAvailable};
+        std::vector<VkPipelineStageFlags> waitStages{toVulkan(PipelineStage::ColorAttachmentOutput)};
+        std::vector<uint64_t>             waitValues{0};
+        waitSemaphores.reserve(waits.size + 1);
+        waitStages.reserve(waits.size + 1);
+        waitValues.reserve(waits.size + 1);
+
+        bool hasTimeline = false;
+        for (const SemaphoreWait& wait : waits)
+        {
+            waitSemaphores.emplace_back(wait.semaphore->getHandle());
+            waitStages.emplace_back(toVulkan(wait.stage));
+            waitValues.emplace_back(wait.value);
+            hasTimeline |= wait.semaphore->getType() == SemaphoreType::Timeline;
+        }
+
+        // Values of binary semaphores are ignored
+        VkTimelineSemaphoreSubmitInfo timelineInfo{};
+        timelineInfo.sType                   = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineInfo.waitSemaphoreValueCount = static_cast<uint32_t>(waitValues.size());
+        timelineInfo.pWaitSemaphoreValues    = waitValues.data();
+
         VkSubmitInfo submitInfo{};
-        submitInfo.sType                         = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        constexpr VkPipelineStageFlags waitStage = toVulkan(PipelineStage::ColorAttachmentOutput);
-        submitInfo.pWaitDstStageMask             = &waitStage;
-        submitInfo.waitSemaphoreCount            = 1;
-        submitInfo.pWaitSemaphores               = &submission.imageAvailable;
-        submitInfo.signalSemaphoreCount          = 1;
-        submitInfo.pSignalSemaphores             = &submission.renderComplete;
-        submitInfo.commandBufferCount            = 1;
-        submitInfo.pCommandBuffers               = &commands;
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext                = hasTimeline ? &timelineInfo : nullptr;
+        submitInfo.pWaitDstStageMask    = waitStages.data();
+        submitInfo.waitSemaphoreCount   = static_cast<uint32_t>(waitSemaphores.size());
+        submitInfo.pWaitSemaphores      = waitSemaphores.data();
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores    = &submission.renderComplete;
+        submitInfo.commandBufferCount   = 1;
+        submitInfo.pCommandBuffers      = &commands;
 
         const VolkDeviceTable& table = m_device->getFunctionTable();
         table.vkResetFences(m_device->getHandle(), 1, &submission.frameComplete);
@@ -533,4 +810,78 @@ namespace vzt
         table.vkQueueSubmit(m_handle, 1, &submitInfo, VK_NULL_HANDLE);
         table.vkQueueWaitIdle(m_handle);
     }
+
+    void Queue::submit(const CommandBuffer& commandBuffer, View<Semaphore> signal) const
+    {
+        const VkCommandBuffer commands  = commandBuffer.getHandle();
+        const VkSemaphore     semaphore = signal->getHandle();
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount   = 1;
+        submitInfo.pCommandBuffers      = &commands;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores    = &semaphore;
+
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        vkCheck(table.vkQueueSubmit(m_handle, 1, &submitInfo, VK_NULL_HANDLE), "Failed to submit commands");
+    }
+
+    void Queue::submit(const CommandBuffer& commandBuffer, const Fence& fence) const
+    {
+        const VkCommandBuffer commands = commandBuffer.getHandle();
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers    = &commands;
+
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        vkCheck(table.vkQueueSubmit(m_handle, 1, &submitInfo, fence.getHandle()), "Failed to submit commands");
+    }
+
+    SubmissionFuture Queue::submit(const CommandBuffer& commandBuffer, const Semaphore& timeline, uint64_t value,
+                                   CSpan<SemaphoreWait> waits) const
+    {
+        assert(timeline.getType() == SemaphoreType::Timeline && "Async submissions need a timeline semaphore");
+
+        const VkCommandBuffer commands  = commandBuffer.getHandle();
+        const VkSemaphore     semaphore = timeline.getHandle();
+
+        std::vector<VkSemaphore>          waitSemaphores{};
+        std::vector<VkPipelineStageFlags> waitStages{};
+        std::vector<uint64_t>             waitValues{};
+        waitSemaphores.reserve(waits.size);
+        waitStages.reserve(waits.size);
+        waitValues.reserve(waits.size);
+        for (const SemaphoreWait& wait : waits)
+        {
+            waitSemaphores.emplace_back(wait.semaphore->getHandle());
+            waitStages.emplace_back(toVulkan(wait.stage));
+            waitValues.emplace_back(wait.value);
+        }
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo{};
+        timelineInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineInfo.waitSemaphoreValueCount   = static_cast<uint32_t>(waitValues.size());
+        timelineInfo.pWaitSemaphoreValues      = waitValues.data();
+        timelineInfo.signalSemaphoreValueCount = 1;
+        timelineInfo.pSignalSemaphoreValues    = &value;
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext                = &timelineInfo;
+        submitInfo.pWaitDstStageMask    = waitStages.data();
+        submitInfo.waitSemaphoreCount   = static_cast<uint32_t>(waitSemaphores.size());
+        submitInfo.pWaitSemaphores      = waitSemaphores.data();
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores    = &semaphore;
+        submitInfo.commandBufferCount   = 1;
+        submitInfo.pCommandBuffers      = &commands;
+
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        vkCheck(table.vkQueueSubmit(m_handle, 1, &submitInfo, VK_NULL_HANDLE), "Failed to submit commands");
+
+        return {&timeline, value};
+    }
 } // namespace vzt
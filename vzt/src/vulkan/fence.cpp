@@ -0,0 +1,47 @@
+#include "vzt/vulkan/fence.hpp"
+
+namespace vzt
+{
+    Fence::Fence(View<Device> device, bool signaled) : DeviceObject<VkFence>(device)
+    {
+        VkFenceCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        if (signaled)
+            createInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        vkCheck(table.vkCreateFence(m_device->getHandle(), &createInfo, nullptr, &m_handle), "Failed to create fence.");
+    }
+
+    Fence::~Fence()
+    {
+        if (m_handle == VK_NULL_HANDLE)
+            return;
+
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        table.vkDestroyFence(m_device->getHandle(), m_handle, nullptr);
+    }
+
+    bool Fence::wait(uint64_t timeout) const
+    {
+        const VolkDeviceTable& table  = m_device->getFunctionTable();
+        const VkResult         result = table.vkWaitForFences(m_device->getHandle(), 1, &m_handle, VK_TRUE, timeout);
+        if (result == VK_TIMEOUT)
+            return false;
+
+        vkCheck(result, "Failed to wait for fence.");
+        return result == VK_SUCCESS;
+    }
+
+    bool Fence::isSignaled() const
+    {
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        return table.vkGetFenceStatus(m_device->getHandle(), m_handle) == VK_SUCCESS;
+    }
+
+    void Fence::reset() const
+    {
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        vkCheck(table.vkResetFences(m_device->getHandle(), 1, &m_handle), "Failed to reset fence.");
+    }
+} // namespace vzt
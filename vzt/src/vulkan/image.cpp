@@ -1,12 +1,13 @@
 #include "vzt/vulkan/image.hpp"
 
+#include <cstring>
 #include <utility>
 
 #include "vzt/core/logger.hpp"
 #include "vzt/vulkan/buffer.hpp"
 #include "vzt/vulkan/command.hpp"
 #include "vzt/vulkan/device.hpp"
-#include "vzt/vulkan/image.hpp"
+#include "vzt/vulkan/upload.hpp"
 
 namespace vzt
 {
@@ -14,60 +15,92 @@ namespace vzt
                                   const CSpan<uint8_t> data, uint32_t mipLevels, SampleCount sampleCount,
                                   ImageType type, SharingMode sharingMode, ImageTiling tiling, bool)
     {
+        usage |= ImageUsage::TransferDst;
+        if (mipLevels > 1)
+            usage |= ImageUsage::TransferSrc;
+
         DeviceImage deviceImage{
-            device,
-            Extent2D{width, height},
-            usage | vzt::ImageUsage::TransferDst,
-            format,
-            mipLevels,
-            sampleCount,
-            type,
-            sharingMode,
-            tiling,
+            device, Extent2D{width, height}, usage, format, mipLevels, sampleCount, type, sharingMode, tiling,
         };
-        auto staging = Buffer::From(device, data, vzt::BufferUsage::TransferSrc, vzt::MemoryLocation::Device);
 
-        const auto graphicsQueue = device->getQueue(vzt::QueueType::Graphics);
-        graphicsQueue->oneShot([&](vzt::CommandBuffer& commands) {
-            vzt::ImageBarrier imageBarrier{};
-            imageBarrier.image     = deviceImage;
-            imageBarrier.dst       = Access::TransferWrite;
-            imageBarrier.oldLayout = vzt::ImageLayout::Undefined;
-            imageBarrier.newLayout = vzt::ImageLayout::TransferDstOptimal;
-            commands.barrier(vzt::PipelineStage::Transfer, vzt::PipelineStage::Transfer, imageBarrier);
+        UploadManager& uploader = device->getUploadManager();
+        if (mipLevels == 1 || uploader.canGenerateMipmaps())
+        {
+            uploader.wait(uploader.upload(data, deviceImage, width, height));
+            return deviceImage;
+        }
+
+        // Dedicated transfer queues cannot blit, the whole upload is then performed on the graphics queue so that the
+        // image is not transferred between queue families
+        Buffer staging{device, data.size, BufferUsage::TransferSrc, MemoryLocation::Host, true};
+        std::memcpy(staging.map(), data.data, data.size);
+        staging.unMap();
+
+        device->getQueue(QueueType::Graphics)->oneShot([&](CommandBuffer& commands) {
+            ImageBarrier barrier{};
+            barrier.image      = deviceImage;
+            barrier.oldLayout  = ImageLayout::Undefined;
+            barrier.newLayout  = ImageLayout::TransferDstOptimal;
+            barrier.dst        = Access::TransferWrite;
+            barrier.levelCount = mipLevels;
+            commands.barrier(PipelineStage::Transfer, PipelineStage::Transfer, barrier);
 
             commands.copy(staging, deviceImage, width, height);
+            commands.generateMipmaps(deviceImage);
         });
 
         return deviceImage;
     }
 
+    static VkImageCreateInfo toImageCreateInfo(const ImageBuilder& builder)
+    {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType     = toVulkan(builder.type);
+        imageInfo.format        = toVulkan(builder.format);
+        imageInfo.extent        = {builder.size.width, builder.size.height, builder.size.depth};
+        imageInfo.mipLevels     = builder.mipLevels;
+        imageInfo.arrayLayers   = 1;
+        imageInfo.samples       = toVulkan(builder.sampleCount);
+        imageInfo.tiling        = toVulkan(builder.tiling);
+        imageInfo.usage         = toVulkan(builder.usage | ImageUsage::Sampled);
+        imageInfo.sharingMode   = toVulkan(builder.sharingMode);
+        imageInfo.initialLayout = toVulkan(ImageLayout::Undefined);
+
+        return imageInfo;
+    }
+
     DeviceImage::DeviceImage(View<Device> device, Extent3D size, ImageUsage usage, Format format, uint32_t mipLevels,
                              SampleCount sampleCount, ImageType type, SharingMode sharingMode, ImageTiling tiling,
                              bool mappable)
         : DeviceObject<VkImage>(device), m_size(size), m_usage(usage), m_format(format), m_mipLevels(mipLevels),
           m_sampleCount(sampleCount), m_type(type), m_sharingMode(sharingMode), m_tiling(tiling), m_mappable(mappable)
     {
-        VkImageCreateInfo imageInfo{};
-        imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-        imageInfo.imageType     = toVulkan(m_type);
-        imageInfo.format        = toVulkan(m_format);
-        imageInfo.extent        = {m_size.width, m_size.height, m_size.depth};
-        imageInfo.mipLevels     = m_mipLevels;
-        imageInfo.arrayLayers   = 1;
-        imageInfo.samples       = toVulkan(m_sampleCount);
-        imageInfo.tiling        = toVulkan(m_tiling);
-        imageInfo.usage         = toVulkan(m_usage | ImageUsage::Sampled);
-        imageInfo.sharingMode   = toVulkan(m_sharingMode);
-        imageInfo.initialLayout = toVulkan(ImageLayout::Undefined);
+        const VkImageCreateInfo imageInfo = toImageCreateInfo({
+            .size        = m_size,
+            .usage       = m_usage,
+            .format      = m_format,
+            .mipLevels   = m_mipLevels,
+            .sampleCount = m_sampleCount,
+            .type        = m_type,
+            .sharingMode = m_sharingMode,
+            .tiling      = m_tiling,
+        });
 
         VmaAllocationCreateInfo allocInfo = {};
         allocInfo.usage                   = VMA_MEMORY_USAGE_AUTO;
         if (m_mappable)
+        {
             allocInfo.flags |= VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+            allocInfo.flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        }
 
-        vkCheck(vmaCreateImage(m_device->getAllocator(), &imageInfo, &allocInfo, &m_handle, &m_allocation, nullptr),
+        VmaAllocationInfo allocationInfo{};
+        vkCheck(vmaCreateImage(m_device->getAllocator(), &imageInfo, &allocInfo, &m_handle, &m_allocation,
+                               &allocationInfo),
                 "Can't allocate image.");
+
+        m_mapped = static_cast<uint8_t*>(allocationInfo.pMappedData);
     }
 
     DeviceImage::DeviceImage(View<Device> device, ImageBuilder builder)
@@ -76,6 +109,16 @@ namespace vzt
     {
     }
 
+    DeviceImage::DeviceImage(View<Device> device, ImageBuilder builder, const DeviceMemory& memory, uint64_t offset)
+        : DeviceObject<VkImage>(device), m_aliased(true), m_size(builder.size), m_usage(builder.usage),
+          m_format(builder.format), m_mipLevels(builder.mipLevels), m_sampleCount(builder.sampleCount),
+          m_type(builder.type), m_sharingMode(builder.sharingMode), m_tiling(builder.tiling), m_mappable(false)
+    {
+        const VkImageCreateInfo imageInfo = toImageCreateInfo(builder);
+        vkCheck(vmaCreateAliasingImage2(m_device->getAllocator(), memory.getHandle(), offset, &imageInfo, &m_handle),
+                "Can't create aliased image.");
+    }
+
     DeviceImage::DeviceImage(View<Device> device, VkImage image, Extent3D size, ImageUsage usage, Format format,
                              SharingMode sharingMode, ImageTiling tiling, bool mappable)
         : DeviceObject(device, image), m_size(size), m_usage(usage), m_format(format), m_sharingMode(sharingMode),
@@ -85,6 +128,7 @@ namespace vzt
 
     DeviceImage::DeviceImage(DeviceImage&& other) noexcept
         : DeviceObject(std::move(other)), m_allocation(std::exchange(other.m_allocation, VK_NULL_HANDLE)),
+          m_mapped(std::exchange(other.m_mapped, nullptr)), m_aliased(std::exchange(other.m_aliased, false)),
           m_size(std::move(other.m_size)), m_usage(std::move(other.m_usage)), m_format(std::move(other.m_format)),
           m_mipLevels(std::move(other.m_mipLevels)), m_sampleCount(std::move(other.m_sampleCount)),
           m_type(std::move(other.m_type)), m_sharingMode(std::move(other.m_sharingMode)),
@@ -95,6 +139,8 @@ namespace vzt
     DeviceImage& DeviceImage::operator=(DeviceImage&& other) noexcept
     {
         std::swap(m_allocation, other.m_allocation);
+        std::swap(m_mapped, other.m_mapped);
+        std::swap(m_aliased, other.m_aliased);
         std::swap(m_size, other.m_size);
         std::swap(m_usage, other.m_usage);
         std::swap(m_format, other.m_format);
@@ -111,6 +157,14 @@ namespace vzt
 
     DeviceImage::~DeviceImage()
     {
+        // Aliased images only own their handle, not the memory they are placed on
+        if (m_aliased && m_handle != VK_NULL_HANDLE)
+        {
+            const VolkDeviceTable& table = m_device->getFunctionTable();
+            table.vkDestroyImage(m_device->getHandle(), m_handle, nullptr);
+            return;
+        }
+
         // If the object did not created the handle (i.e. for swapchain images)
         if (m_allocation == VK_NULL_HANDLE)
             return;
@@ -121,6 +175,8 @@ namespace vzt
     uint8_t* DeviceImage::map()
     {
         assert(m_mappable && "Device image has not been tagged as mappable at creation!");
+        if (m_mapped)
+            return m_mapped;
 
         uint8_t* mappedData;
         vmaMapMemory(m_device->getAllocator(), m_allocation, reinterpret_cast<void**>(&mappedData));
@@ -131,6 +187,8 @@ namespace vzt
     const uint8_t* DeviceImage::map() const
     {
         assert(m_mappable && "Device image has not been tagged as mappable at creation!");
+        if (m_mapped)
+            return m_mapped;
 
         uint8_t* mappedData;
         vmaMapMemory(m_device->getAllocator(), m_allocation, reinterpret_cast<void**>(&mappedData));
@@ -138,7 +196,27 @@ namespace vzt
         return mappedData;
     }
 
-    void DeviceImage::unmap() const { vmaUnmapMemory(m_device->getAllocator(), m_allocation); }
+    void DeviceImage::unmap() const
+    {
+        if (m_mapped)
+        {
+            flush();
+            return;
+        }
+
+        vmaUnmapMemory(m_device->getAllocator(), m_allocation);
+    }
+
+    void DeviceImage::flush(uint64_t offset, uint64_t size) const
+    {
+        vkCheck(vmaFlushAllocation(m_device->getAllocator(), m_allocation, offset, size), "Failed to flush image.");
+    }
+
+    void DeviceImage::invalidate(uint64_t offset, uint64_t size) const
+    {
+        vkCheck(vmaInvalidateAllocation(m_device->getAllocator(), m_allocation, offset, size),
+                "Failed to invalidate image.");
+    }
 
     SubresourceLayout DeviceImage::getSubresourceLayout(const ImageAspect, uint32_t, uint32_t) const
     {
@@ -150,6 +228,22 @@ namespace vzt
                 subResourceLayout.arrayPitch, subResourceLayout.depthPitch};
     }
 
+    MemoryRequirements DeviceImage::getMemoryRequirements(View<Device> device, const ImageBuilder& builder)
+    {
+        const VkImageCreateInfo imageInfo = toImageCreateInfo(builder);
+
+        // Requirements are queried on a temporary handle to stay compatible with devices without maintenance4
+        VkImage                image = VK_NULL_HANDLE;
+        const VolkDeviceTable& table = device->getFunctionTable();
+        vkCheck(table.vkCreateImage(device->getHandle(), &imageInfo, nullptr, &image), "Can't create image.");
+
+        VkMemoryRequirements requirements;
+        table.vkGetImageMemoryRequirements(device->getHandle(), image, &requirements);
+        table.vkDestroyImage(device->getHandle(), image, nullptr);
+
+        return {requirements.size, requirements.alignment, requirements.memoryTypeBits};
+    }
+
     ImageView::ImageView(View<Device> device, View<DeviceImage> image, ImageViewType type, ImageAspect aspect,
                          Format format, uint32_t baseMipLevel, uint32_t levelCount)
         : m_device(device), m_image(image), m_aspect(aspect), m_format(format)
@@ -0,0 +1,41 @@
+#include "vzt/vulkan/memory.hpp"
+
+namespace vzt
+{
+    DeviceMemory::DeviceMemory(View<Device> device, MemoryRequirements requirements)
+        : DeviceObject<VmaAllocation>(device), m_size(requirements.size)
+    {
+        VkMemoryRequirements memoryRequirements{};
+        memoryRequirements.size           = requirements.size;
+        memoryRequirements.alignment      = requirements.alignment;
+        memoryRequirements.memoryTypeBits = requirements.memoryTypeBits;
+
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.usage                   = VMA_MEMORY_USAGE_UNKNOWN;
+        allocInfo.requiredFlags           = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+        vkCheck(vmaAllocateMemory(m_device->getAllocator(), &memoryRequirements, &allocInfo, &m_handle, nullptr),
+                "Failed to allocate device memory.");
+    }
+
+    DeviceMemory::DeviceMemory(DeviceMemory&& other) noexcept : DeviceObject<VmaAllocation>(std::move(other))
+    {
+        std::swap(m_size, other.m_size);
+    }
+
+    DeviceMemory& DeviceMemory::operator=(DeviceMemory&& other) noexcept
+    {
+        std::swap(m_size, other.m_size);
+
+        DeviceObject<VmaAllocation>::operator=(std::move(other));
+        return *this;
+    }
+
+    DeviceMemory::~DeviceMemory()
+    {
+        if (m_handle == VK_NULL_HANDLE)
+            return;
+
+        vmaFreeMemory(m_device->getAllocator(), m_handle);
+    }
+} // namespace vzt
@@ -0,0 +1,21 @@
+#include "vzt/vulkan/pipeline/async_compiler.hpp"
+
+namespace vzt
+{
+    AsyncPipelineCompiler::AsyncPipelineCompiler(uint32_t threadNb) : m_threads(threadNb) {}
+
+    std::future<GraphicsPipeline> AsyncPipelineCompiler::compile(GraphicsPipelineBuilder builder)
+    {
+        return submit<GraphicsPipeline>([builder = std::move(builder)] { return GraphicsPipeline(builder); });
+    }
+
+    std::future<ComputePipeline> AsyncPipelineCompiler::compile(View<Program> program)
+    {
+        return submit<ComputePipeline>([program] { return ComputePipeline(*program); });
+    }
+
+    std::future<RaytracingPipeline> AsyncPipelineCompiler::compile(View<ShaderGroup> shaderGroup)
+    {
+        return submit<RaytracingPipeline>([shaderGroup] { return RaytracingPipeline(*shaderGroup); });
+    }
+} // namespace vzt
@@ -0,0 +1,134 @@
+#include "vzt/vulkan/pipeline/cache.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#include "vzt/core/logger.hpp"
+
+namespace vzt
+{
+    PipelineCache PipelineCache::From(View<Device> device, const Path& path)
+    {
+        if (!std::filesystem::exists(path))
+            return {device};
+
+        const std::string    content = readFile(path);
+        const CSpan<uint8_t> data    = {reinterpret_cast<const uint8_t*>(content.data()), content.size()};
+        if (!IsCompatible(device, data))
+        {
+            logger::info("[PipelineCache] {} was created by another driver or device, starting empty.", path.string());
+            return {device};
+        }
+
+        return {device, data};
+    }
+
+    bool PipelineCache::IsCompatible(View<Device> device, CSpan<uint8_t> data)
+    {
+        VkPipelineCacheHeaderVersionOne header{};
+        if (data.size < sizeof(VkPipelineCacheHeaderVersionOne))
+            return false;
+
+        std::memcpy(&header, data.data, sizeof(VkPipelineCacheHeaderVersionOne));
+        if (header.headerSize < sizeof(VkPipelineCacheHeaderVersionOne) ||
+            header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE)
+            return false;
+
+        const VkPhysicalDeviceProperties properties = device->getHardware().getProperties();
+        return header.vendorID == properties.vendorID && header.deviceID == properties.deviceID &&
+               std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
+
+    PipelineCache::PipelineCache(View<Device> device, CSpan<uint8_t> initialData)
+        : DeviceObject<VkPipelineCache>(device)
+    {
+        VkPipelineCacheCreateInfo createInfo{};
+        createInfo.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.initialDataSize = initialData.size;
+        createInfo.pInitialData    = initialData.data;
+
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        vkCheck(table.vkCreatePipelineCache(m_device->getHandle(), &createInfo, nullptr, &m_handle),
+                "Failed to create pipeline cache.");
+    }
+
+    PipelineCache::PipelineCache(PipelineCache&& other) noexcept : DeviceObject<VkPipelineCache>(std::move(other)) {}
+
+    PipelineCache& PipelineCache::operator=(PipelineCache&& other) noexcept
+    {
+        DeviceObject<VkPipelineCache>::operator=(std::move(other));
+        return *this;
+    }
+
+    PipelineCache::~PipelineCache()
+    {
+        if (m_handle == VK_NULL_HANDLE)
+            return;
+
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        table.vkDestroyPipelineCache(m_device->getHandle(), m_handle, nullptr);
+    }
+
+    void PipelineCache::merge(const PipelineCache& other)
+    {
+        std::lock_guard lock{m_mergeMutex};
+
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        vkCheck(table.vkMergePipelineCaches(m_device->getHandle(), m_handle, 1, &other.m_handle),
+                "Failed to merge pipeline caches.");
+    }
+
+    std::vector<uint8_t> PipelineCache::getData() const
+    {
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+
+        // The size may grow between the two calls if pipelines are being created, which is reported as VK_INCOMPLETE
+        std::vector<uint8_t> data;
+        VkResult             result = VK_INCOMPLETE;
+        while (result == VK_INCOMPLETE)
+        {
+            std::size_t size = 0;
+            table.vkGetPipelineCacheData(m_device->getHandle(), m_handle, &size, nullptr);
+
+            data.resize(size);
+            result = table.vkGetPipelineCacheData(m_device->getHandle(), m_handle, &size, data.data());
+            data.resize(size);
+        }
+
+        vkCheck(result, "Failed to get pipeline cache data.");
+        return data;
+    }
+
+    bool PipelineCache::save(const Path& path) const
+    {
+        const std::vector<uint8_t> data = getData();
+
+        std::error_code error;
+        if (path.has_parent_path())
+            std::filesystem::create_directories(path.parent_path(), error);
+
+        // Written aside and renamed so that an interrupted save does not leave a truncated cache
+        Path temporary = path;
+        temporary += ".tmp";
+        {
+            std::ofstream file{temporary, std::ios::binary | std::ios::trunc};
+            if (!file.is_open())
+            {
+                logger::warn("[PipelineCache] Failed to write {}.", path.string());
+                return false;
+            }
+
+            file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        }
+
+        std::filesystem::rename(temporary, path, error);
+        if (error)
+        {
+            logger::warn("[PipelineCache] Failed to write {}: {}.", path.string(), error.message());
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+
+        return true;
+    }
+} // namespace vzt
@@ -1,6 +1,7 @@
 #include "vzt/vulkan/pipeline/compute.hpp"
 
 #include "vzt/vulkan/device.hpp"
+#include "vzt/vulkan/pipeline/cache.hpp"
 #include "vzt/vulkan/program.hpp"
 
 namespace vzt
@@ -81,11 +82,13 @@ namespace vzt
         createInfo.stage         = toVulkan(shader.stage);
         createInfo.pName         = "main";
 
+        createInfo.pSpecializationInfo = shaderModule.getSpecializationInfo();
+
         pipelineInfo.stage = createInfo;
 
-        vkCheck(
-            table.vkCreateComputePipelines(m_device->getHandle(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_handle),
-            "Failed to create compute pipeline.");
+        const VkPipelineCache cache = m_device->getPipelineCache().getHandle();
+        vkCheck(table.vkCreateComputePipelines(m_device->getHandle(), cache, 1, &pipelineInfo, nullptr, &m_handle),
+                "Failed to create compute pipeline.");
 
         m_compiled = true;
     }
@@ -4,6 +4,7 @@
 
 #include "vzt/vulkan/command.hpp"
 #include "vzt/vulkan/device.hpp"
+#include "vzt/vulkan/pipeline/cache.hpp"
 
 namespace vzt
 {
@@ -162,6 +163,8 @@ namespace vzt
                 createInfo.stage  = toVulkan(shader.stage);
                 createInfo.pName  = "main";
 
+                createInfo.pSpecializationInfo = shaderModule.getSpecializationInfo();
+
                 shaderStages.emplace_back(createInfo);
             }
             pipelineInfo.stageCount = static_cast<uint32_t>(shaderStages.size());
@@ -236,8 +239,8 @@ namespace vzt
         pipelineInfo.basePipelineHandle = nullptr;
         pipelineInfo.basePipelineIndex  = 0;
 
-        vkCheck(table.vkCreateGraphicsPipelines(m_device->getHandle(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr,
-                                                &m_handle),
+        const VkPipelineCache cache = m_device->getPipelineCache().getHandle();
+        vkCheck(table.vkCreateGraphicsPipelines(m_device->getHandle(), cache, 1, &pipelineInfo, nullptr, &m_handle),
                 "Failed to create graphics pipeline.");
     }
 
@@ -3,6 +3,7 @@
 #include <stdexcept>
 
 #include "vzt/vulkan/device.hpp"
+#include "vzt/vulkan/pipeline/cache.hpp"
 #include "vzt/vulkan/program.hpp"
 
 namespace vzt
@@ -150,6 +151,8 @@ namespace vzt
             createInfo.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
             createInfo.stage  = toVulkan(stage);
             createInfo.pName  = "main";
+
+            createInfo.pSpecializationInfo = shaderModule.getSpecializationInfo();
             shaderStages.emplace_back(createInfo);
         }
 
@@ -162,10 +165,10 @@ namespace vzt
         rayTracingPipelineCI.maxPipelineRayRecursionDepth = 1;
         rayTracingPipelineCI.layout                       = m_pipelineLayout;
 
-        vkCheck(
-            table.vkCreateRayTracingPipelinesKHR( //
-                m_device->getHandle(), VK_NULL_HANDLE, VK_NULL_HANDLE, 1, &rayTracingPipelineCI, nullptr, &m_handle),
-            "Can't create raytracing pipeline.");
+        const VkPipelineCache cache = m_device->getPipelineCache().getHandle();
+        vkCheck(table.vkCreateRayTracingPipelinesKHR( //
+                    m_device->getHandle(), VK_NULL_HANDLE, cache, 1, &rayTracingPipelineCI, nullptr, &m_handle),
+                "Can't create raytracing pipeline.");
 
         VkPhysicalDeviceRayTracingPipelinePropertiesKHR rayTracingPipelineProperties{};
         rayTracingPipelineProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_PROPERTIES_KHR;
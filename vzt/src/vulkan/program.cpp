@@ -1,5 +1,7 @@
 #include "vzt/vulkan/program.hpp"
 
+#include <cstddef>
+
 #include "vzt/vulkan/device.hpp"
 
 namespace vzt
@@ -14,16 +16,35 @@ namespace vzt
 
         vkCheck(vkCreateShaderModule(m_device->getHandle(), &shaderModuleCreateInfo, nullptr, &m_handle),
                 "Failed to create shader module.");
+
+        const std::vector<SpecializationConstant>& constants = m_shader.specializationConstants;
+        m_specializationEntries.reserve(constants.size());
+        for (std::size_t i = 0; i < constants.size(); i++)
+        {
+            const std::size_t offset = i * sizeof(SpecializationConstant) + offsetof(SpecializationConstant, value);
+            m_specializationEntries.emplace_back(
+                VkSpecializationMapEntry{constants[i].id, static_cast<uint32_t>(offset), sizeof(uint32_t)});
+        }
+
+        m_specializationInfo.mapEntryCount = static_cast<uint32_t>(m_specializationEntries.size());
+        m_specializationInfo.pMapEntries   = m_specializationEntries.data();
+        m_specializationInfo.dataSize      = constants.size() * sizeof(SpecializationConstant);
+        m_specializationInfo.pData         = constants.data();
     }
 
+    // Swapped vectors keep their storage, so that specialization info stays valid
     ShaderModule::ShaderModule(ShaderModule&& other) noexcept : DeviceObject<VkShaderModule>(std::move(other))
     {
         std::swap(m_shader, other.m_shader);
+        std::swap(m_specializationEntries, other.m_specializationEntries);
+        std::swap(m_specializationInfo, other.m_specializationInfo);
     }
 
     ShaderModule& ShaderModule::operator=(ShaderModule&& other) noexcept
     {
         std::swap(m_shader, other.m_shader);
+        std::swap(m_specializationEntries, other.m_specializationEntries);
+        std::swap(m_specializationInfo, other.m_specializationInfo);
 
         DeviceObject<VkShaderModule>::operator=(std::move(other));
         return *this;
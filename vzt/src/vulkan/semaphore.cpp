@@ -0,0 +1,80 @@
+#include "vzt/vulkan/semaphore.hpp"
+
+#include "vzt/core/assert.hpp"
+
+namespace vzt
+{
+    Semaphore::Semaphore(View<Device> device, SemaphoreType type, uint64_t initialValue)
+        : DeviceObject<VkSemaphore>(device), m_type(type)
+    {
+        VkSemaphoreTypeCreateInfo typeInfo{};
+        typeInfo.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        typeInfo.semaphoreType = toVulkan(type);
+        typeInfo.initialValue  = initialValue;
+
+        VkSemaphoreCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        if (type == SemaphoreType::Timeline)
+            createInfo.pNext = &typeInfo;
+
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        vkCheck(table.vkCreateSemaphore(m_device->getHandle(), &createInfo, nullptr, &m_handle),
+                "Failed to create semaphore.");
+    }
+
+    Semaphore::~Semaphore()
+    {
+        if (m_handle == VK_NULL_HANDLE)
+            return;
+
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        table.vkDestroySemaphore(m_device->getHandle(), m_handle, nullptr);
+    }
+
+    uint64_t Semaphore::getValue() const
+    {
+        VZT_ASSERT(m_type == SemaphoreType::Timeline);
+
+        uint64_t               value = 0;
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        vkCheck(table.vkGetSemaphoreCounterValue(m_device->getHandle(), m_handle, &value),
+                "Failed to get semaphore value.");
+
+        return value;
+    }
+
+    bool Semaphore::wait(uint64_t value, uint64_t timeout) const
+    {
+        VZT_ASSERT(m_type == SemaphoreType::Timeline);
+
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores    = &m_handle;
+        waitInfo.pValues        = &value;
+
+        const VolkDeviceTable& table  = m_device->getFunctionTable();
+        const VkResult         result = table.vkWaitSemaphores(m_device->getHandle(), &waitInfo, timeout);
+        if (result == VK_TIMEOUT)
+            return false;
+
+        vkCheck(result, "Failed to wait for semaphore.");
+        return result == VK_SUCCESS;
+    }
+
+    void Semaphore::signal(uint64_t value) const
+    {
+        VZT_ASSERT(m_type == SemaphoreType::Timeline);
+
+        VkSemaphoreSignalInfo signalInfo{};
+        signalInfo.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+        signalInfo.semaphore = m_handle;
+        signalInfo.value     = value;
+
+        const VolkDeviceTable& table = m_device->getFunctionTable();
+        vkCheck(table.vkSignalSemaphore(m_device->getHandle(), &signalInfo), "Failed to signal semaphore.");
+    }
+
+    bool SubmissionFuture::isReady() const { return semaphore->getValue() >= value; }
+    void SubmissionFuture::wait() const { semaphore->wait(value); }
+} // namespace vzt
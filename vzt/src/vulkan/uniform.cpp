@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "vzt/core/assert.hpp"
 #include "vzt/vulkan/uniform.hpp"
 
@@ -27,6 +29,12 @@ namespace vzt
 
     void UniformBuffer::unMap() const { m_buffer.unMap(); }
 
+    void UniformBuffer::flush(uint32_t frame) const
+    {
+        VZT_ASSERT(frame < m_frameNb);
+        m_buffer.flush(frame * m_alignmentByteNb, m_perFrameByteNb);
+    }
+
     [[nodiscard]] BufferSpan UniformBuffer::getSpan(uint32_t frame)
     {
         VZT_ASSERT(frame < m_frameNb);
@@ -46,4 +54,53 @@ namespace vzt
         return vzt::DescriptorBuffer{vzt::DescriptorType::UniformBuffer, span};
     }
 
+    DynamicUniformBuffer::DynamicUniformBuffer(View<Device> device, std::size_t perFrameByteNb, uint32_t frameNb,
+                                               std::size_t range)
+        : m_range(range), m_frameNb(frameNb)
+    {
+        VZT_ASSERT(range > 0 && range <= perFrameByteNb);
+
+        const auto                   hardware = device->getHardware();
+        const VkPhysicalDeviceLimits limits   = hardware.getProperties().limits;
+
+        m_regionByteNb = hardware.getUniformAlignment(perFrameByteNb);
+        m_alignment    = std::max<std::size_t>(1, limits.minUniformBufferOffsetAlignment);
+
+        // The descriptor reads range bytes after any offset, the last region needs this much slack
+        m_buffer = Buffer(device, m_regionByteNb * frameNb + range, BufferUsage::UniformBuffer,
+                          MemoryLocation::Device, true);
+        m_data   = m_buffer.map();
+    }
+
+    void DynamicUniformBuffer::reset(uint32_t frame)
+    {
+        VZT_ASSERT(frame < m_frameNb);
+        m_frame = frame;
+        m_head  = 0;
+    }
+
+    DynamicUniformAllocation DynamicUniformBuffer::allocate(std::size_t byteNb)
+    {
+        VZT_ASSERT(byteNb <= m_range);
+
+        const std::size_t aligned = (m_head + m_alignment - 1) / m_alignment * m_alignment;
+        VZT_ASSERT(aligned + byteNb <= m_regionByteNb && "Dynamic uniform buffer frame region is full");
+
+        m_head = aligned + byteNb;
+
+        const std::size_t offset = m_frame * m_regionByteNb + aligned;
+        return {m_data + offset, static_cast<uint32_t>(offset)};
+    }
+
+    void DynamicUniformBuffer::flush() const
+    {
+        if (m_head > 0)
+            m_buffer.flush(m_frame * m_regionByteNb, m_head);
+    }
+
+    DescriptorBuffer DynamicUniformBuffer::getDescriptor() const
+    {
+        const vzt::BufferCSpan span = {m_buffer, m_range, 0};
+        return vzt::DescriptorBuffer{vzt::DescriptorType::UniformBufferDynamic, span};
+    }
 } // namespace vzt
\ No newline at end of file
@@ -0,0 +1,286 @@
+#include "vzt/vulkan/upload.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "vzt/core/assert.hpp"
+#include "vzt/vulkan/image.hpp"
+
+namespace vzt
+{
+    UploadManager::UploadManager(View<Device> device, uint64_t size, uint32_t batchNb)
+        : m_device(device), m_queue(device->getQueue(QueueType::Transfer)),
+          m_timeline(device, SemaphoreType::Timeline)
+    {
+        VZT_ASSERT(size > 0 && batchNb > 0);
+
+        // Offsets of buffer to image copies must be a multiple of the texel size and of 4
+        const VkPhysicalDeviceLimits limits = m_device->getHardware().getProperties().limits;
+        m_alignment = std::max<uint64_t>(m_alignment, limits.optimalBufferCopyOffsetAlignment);
+
+        m_ring = Buffer(device, size, BufferUsage::TransferSrc, MemoryLocation::Host, true);
+        m_data = m_ring.map();
+
+        m_pool = CommandPool(device, m_queue, batchNb);
+        m_batches.resize(batchNb);
+        for (uint32_t i = 0; i < batchNb; i++)
+            m_free.emplace_back(batchNb - 1 - i);
+    }
+
+    UploadManager::~UploadManager()
+    {
+        if (m_current)
+            submit();
+
+        while (!m_inFlight.empty())
+            reclaim(true);
+    }
+
+    UploadToken UploadManager::upload(CSpan<uint8_t> data, const Buffer& destination, uint64_t offset)
+    {
+        VZT_ASSERT(offset + data.size <= destination.size());
+
+        std::lock_guard lock{m_mutex};
+
+        const Staging staging  = stage(data);
+        CommandBuffer commands = getCommands();
+        commands.copy(*staging.buffer, destination, data.size, staging.offset, offset);
+
+        return m_batches[*m_current].token;
+    }
+
+    UploadToken UploadManager::upload(CSpan<uint8_t> data, const DeviceImage& destination, uint32_t width,
+                                      uint32_t height)
+    {
+        std::lock_guard lock{m_mutex};
+
+        const Staging staging  = stage(data);
+        CommandBuffer commands = getCommands();
+
+        ImageBarrier barrier{};
+        barrier.image      = destination;
+        barrier.oldLayout  = ImageLayout::Undefined;
+        barrier.newLayout  = ImageLayout::TransferDstOptimal;
+        barrier.dst        = Access::TransferWrite;
+        barrier.levelCount = destination.getMipLevels();
+        commands.barrier(PipelineStage::Transfer, PipelineStage::Transfer, barrier);
+
+        commands.copy(*staging.buffer, destination, width, height, ImageAspect::Color, staging.offset);
+
+        // Blits require a graphics queue, the mip chain is otherwise left to the caller
+        if (canGenerateMipmaps())
+        {
+            commands.generateMipmaps(destination);
+        }
+        else if (destination.getMipLevels() == 1)
+        {
+            barrier           = {};
+            barrier.image     = destination;
+            barrier.oldLayout = ImageLayout::TransferDstOptimal;
+            barrier.newLayout = ImageLayout::ShaderReadOnlyOptimal;
+            barrier.src       = Access::TransferWrite;
+            commands.barrier(PipelineStage::Transfer, PipelineStage::BottomOfPipe, barrier);
+        }
+
+        return m_batches[*m_current].token;
+    }
+
+    UploadToken UploadManager::flush()
+    {
+        std::lock_guard lock{m_mutex};
+        if (m_current)
+            submit();
+
+        return m_next - 1;
+    }
+
+    bool UploadManager::isComplete(UploadToken token)
+    {
+        std::lock_guard lock{m_mutex};
+        reclaim(false);
+
+        return token <= m_completed;
+    }
+
+    void UploadManager::wait(UploadToken token)
+    {
+        std::lock_guard lock{m_mutex};
+        if (m_current && m_batches[*m_current].token <= token)
+            submit();
+
+        while (m_completed < token && !m_inFlight.empty())
+            reclaim(true);
+    }
+
+    SubmissionFuture UploadManager::getFuture(UploadToken token)
+    {
+        std::lock_guard lock{m_mutex};
+        if (m_current && m_batches[*m_current].token <= token)
+            submit();
+
+        return {m_timeline, token};
+    }
+
+    UploadManager::Staging UploadManager::stage(CSpan<uint8_t> data)
+    {
+        const uint64_t capacity = m_ring.size();
+        if (data.size > capacity)
+        {
+            Buffer staging = {m_device, data.size, BufferUsage::TransferSrc, MemoryLocation::Host, true};
+            std::memcpy(staging.map(), data.data, data.size);
+            staging.flush();
+
+            // The batch must be started before referencing its staging buffer
+            getCommands();
+
+            std::vector<Buffer>& dedicated = m_batches[*m_current].dedicated;
+            dedicated.emplace_back(std::move(staging));
+            return {&dedicated.back(), 0};
+        }
+
+        while (true)
+        {
+            if (m_used == 0)
+                m_head = 0;
+
+            // Free space starts at the head and wraps at the end of the ring
+            const uint64_t available = capacity - m_used;
+            const uint64_t aligned   = (m_head + m_alignment - 1) / m_alignment * m_alignment;
+
+            uint64_t offset  = aligned;
+            uint64_t padding = aligned - m_head;
+            if (aligned + data.size > capacity)
+            {
+                offset  = 0;
+                padding = capacity - m_head;
+            }
+
+            if (padding + data.size <= available)
+            {
+                std::memcpy(m_data + offset, data.data, data.size);
+                m_ring.flush(offset, data.size);
+
+                getCommands();
+                m_batches[*m_current].bytes += padding + data.size;
+
+                m_head = offset + data.size;
+                m_used += padding + data.size;
+                return {&m_ring, offset};
+            }
+
+            // The current batch holds the remaining space, it must be submitted before being reclaimed
+            if (m_inFlight.empty())
+            {
+                VZT_ASSERT(m_current);
+                submit();
+            }
+
+            reclaim(true);
+        }
+    }
+
+    CommandBuffer UploadManager::getCommands()
+    {
+        if (m_current)
+            return m_pool[*m_current];
+
+        // All batches are in flight, the oldest one is recycled
+        if (m_free.empty())
+            reclaim(true);
+
+        m_current = m_free.back();
+        m_free.pop_back();
+
+        Batch& batch = m_batches[*m_current];
+        batch.token  = m_next;
+        batch.bytes  = 0;
+
+        CommandBuffer commands = m_pool[*m_current];
+        commands.begin();
+
+        return commands;
+    }
+
+    void UploadManager::submit()
+    {
+        Batch& batch = m_batches[*m_current];
+
+        CommandBuffer commands = m_pool[*m_current];
+        commands.end();
+
+        m_queue->submit(commands, m_timeline, batch.token);
+
+        m_inFlight.emplace_back(*m_current);
+        m_current.reset();
+        m_next++;
+    }
+
+    void UploadManager::reclaim(bool waitOldest)
+    {
+        while (!m_inFlight.empty())
+        {
+            Batch& batch = m_batches[m_inFlight.front()];
+            if (waitOldest)
+                m_timeline.wait(batch.token);
+            else if (m_timeline.getValue() < batch.token)
+                return;
+
+            m_used -= batch.bytes;
+            m_completed = batch.token;
+            batch.dedicated.clear();
+
+            m_free.emplace_back(m_inFlight.front());
+            m_inFlight.pop_front();
+
+            // Only waits for one batch, others are reclaimed if already complete
+            waitOldest = false;
+        }
+    }
+
+    UploadBatch::UploadBatch(View<Device> device) : m_device(device) {}
+
+    Buffer UploadBatch::createBuffer(CSpan<uint8_t> data, BufferUsage usages, MemoryLocation location)
+    {
+        UploadToken token  = 0;
+        Buffer      buffer = Buffer::FromAsync(m_device, data, usages, token, location);
+        m_token            = std::max(m_token, token);
+
+        return buffer;
+    }
+
+    DeviceImage UploadBatch::createImage(CSpan<uint8_t> data, ImageUsage usage, Format format, uint32_t width,
+                                         uint32_t height, uint32_t mipLevels)
+    {
+        // The mip chain cannot be generated on the queue of the manager, the image is then uploaded on the graphics
+        // queue which also generates it
+        UploadManager& uploader = m_device->getUploadManager();
+        if (mipLevels > 1 && !uploader.canGenerateMipmaps())
+            return DeviceImage::From(m_device, usage, format, width, height, data, mipLevels);
+
+        usage |= ImageUsage::TransferDst;
+        if (mipLevels > 1)
+            usage |= ImageUsage::TransferSrc;
+
+        DeviceImage image{m_device, Extent2D{width, height}, usage, format, mipLevels};
+        m_token = std::max(m_token, uploader.upload(data, image, width, height));
+
+        return image;
+    }
+
+    UploadToken UploadBatch::submit()
+    {
+        if (m_token != 0)
+            m_device->getUploadManager().flush();
+
+        return m_token;
+    }
+
+    void UploadBatch::wait()
+    {
+        // Tokens are increasing, waiting for the last one waits for the whole batch
+        if (m_token != 0)
+            m_device->getUploadManager().wait(m_token);
+
+        m_token = 0;
+    }
+} // namespace vzt